@@ -25,12 +25,11 @@ void RunComputeExample(GLFWwindow* p_window)
 	context.EnableDebugMessages();
 
 	constexpr uint32_t k_particleCount = 4096;
-	std::vector<Particle> particles(k_particleCount); // Heap allocated, due to its size.
 
-	// Storage buffer for particles
+	// Storage buffer for particles, zeroed on the GPU (dead particles get respawned by the compute shader)
 	baregl::Buffer particleBuffer;
-	particleBuffer.Allocate(particles.size() * sizeof(Particle), baregl::types::EAccessSpecifier::DYNAMIC_DRAW);
-	particleBuffer.Upload(particles.data());
+	particleBuffer.Allocate(k_particleCount * sizeof(Particle), baregl::types::EAccessSpecifier::DYNAMIC_DRAW);
+	particleBuffer.Clear();
 
 	// Quad for rendering particles (instanced) - made slightly larger for visibility
 	constexpr float quadVertices[] = {
@@ -121,6 +120,9 @@ void main() {
 	computeProgram.Attach(computeShader);
 	computeProgram.Link();
 
+	// Number of work groups required to update every particle, based on the shader local size
+	const auto workGroupCount = computeProgram.GetComputeWorkGroupCount(k_particleCount);
+
 	// Rendering shaders
 	baregl::ShaderStage vertexShader(baregl::types::EShaderType::VERTEX);
 	vertexShader.Upload(R"(
@@ -202,9 +204,7 @@ void main() {
 		particleBuffer.Bind(baregl::types::EBufferType::SHADER_STORAGE, 0);
 		computeProgram.SetUniform("u_DeltaTime", deltaTime);
 		computeProgram.SetUniform("u_Time", currentTime);
-		constexpr uint32_t k_workGroupSize = 64;
-		constexpr uint32_t k_dispatchSize = (k_particleCount + k_workGroupSize - 1) / k_workGroupSize;
-		context.DispatchCompute(k_dispatchSize, 1, 1);
+		context.DispatchCompute(workGroupCount[0], workGroupCount[1], workGroupCount[2]);
 		context.MemoryBarrier(baregl::types::EMemoryBarrierFlags::SHADER_STORAGE);
 
 		// Render particles
@@ -0,0 +1,98 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/types/EPixelDataFormat.h>
+#include <baregl/types/EPixelDataType.h>
+#include <baregl/Buffer.h>
+#include <baregl/BufferMapping.h>
+#include <baregl/Fence.h>
+#include <baregl/Framebuffer.h>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace baregl
+{
+	/**
+	* Reads pixels back to the CPU without stalling the pipeline.
+	* Pixels are read into a ring of pixel-pack buffers, each guarded by a fence, and can be retrieved
+	* once the GPU is done (usually a few frames later).
+	*/
+	class AsyncReadback final
+	{
+	public:
+		/**
+		* Creates an asynchronous readback ring
+		* @param p_slotSize Size of a single slot in bytes (maximum size of a readback)
+		* @param p_slotCount Number of slots (maximum number of readbacks in flight)
+		*/
+		AsyncReadback(uint64_t p_slotSize, uint32_t p_slotCount = 3);
+
+		/**
+		* Requests a pixel readback from the given framebuffer, or from the currently bound one
+		* @param p_x The x-coordinate of the lower-left corner.
+		* @param p_y The y-coordinate of the lower-left corner.
+		* @param p_width The width of the pixel rectangle.
+		* @param p_height The height of the pixel rectangle.
+		* @param p_format The format of the pixel data.
+		* @param p_type The data type of the pixel data.
+		* @param p_framebuffer (Optional) Framebuffer to read from
+		* @return False if every slot is still in flight (results must be retrieved first)
+		*/
+		bool Request(
+			uint32_t p_x,
+			uint32_t p_y,
+			uint32_t p_width,
+			uint32_t p_height,
+			types::EPixelDataFormat p_format,
+			types::EPixelDataType p_type,
+			std::optional<std::reference_wrapper<const Framebuffer>> p_framebuffer = std::nullopt
+		);
+
+		/**
+		* Returns the oldest readback if the GPU is done with it, without blocking
+		* @note The mapping must be released before the slot gets requested again
+		* @return A read-only mapping of the pixel data (rows are padded to GL_PACK_ALIGNMENT)
+		*/
+		std::optional<BufferMapping> Poll();
+
+		/**
+		* Blocks until the oldest readback is done, and returns it
+		* @note The mapping must be released before the slot gets requested again
+		* @return A read-only mapping of the pixel data, or std::nullopt if no readback is in flight
+		*/
+		std::optional<BufferMapping> Wait();
+
+		/**
+		* Returns the number of readbacks in flight
+		*/
+		uint32_t GetPendingCount() const;
+
+		/**
+		* Returns the number of slots
+		*/
+		uint32_t GetSlotCount() const;
+
+	private:
+		struct Slot
+		{
+			Buffer buffer;
+			Fence fence;
+			uint64_t size = 0;
+		};
+
+		BufferMapping Retrieve();
+
+	private:
+		std::vector<Slot> m_slots;
+		const uint64_t m_slotSize;
+		uint32_t m_head = 0;
+		uint32_t m_pendingCount = 0;
+	};
+}
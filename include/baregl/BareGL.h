@@ -6,14 +6,28 @@
 
 #pragma once
 
+#include <baregl/AsyncReadback.h>
 #include <baregl/Buffer.h>
+#include <baregl/BufferDownload.h>
+#include <baregl/BufferHeap.h>
+#include <baregl/BufferMapping.h>
+#include <baregl/CommandList.h>
 #include <baregl/Context.h>
+#include <baregl/CopyQueue.h>
+#include <baregl/CullingPass.h>
+#include <baregl/Fence.h>
 #include <baregl/Framebuffer.h>
+#include <baregl/PipelineState.h>
 #include <baregl/Renderbuffer.h>
+#include <baregl/RenderQueue.h>
 #include <baregl/ShaderProgram.h>
 #include <baregl/ShaderStage.h>
+#include <baregl/SparseBuffer.h>
+#include <baregl/StreamingBuffer.h>
 #include <baregl/Texture.h>
+#include <baregl/UploadBatcher.h>
 #include <baregl/VertexArray.h>
+#include <baregl/VertexLayoutCache.h>
 
 #include <baregl/debug/Debug.h>
 #include <baregl/debug/IAssertHandler.h>
@@ -9,7 +9,10 @@
 #include <baregl/data/BufferMemoryRange.h>
 #include <baregl/detail/NativeObject.h>
 #include <baregl/types/EAccessSpecifier.h>
+#include <baregl/types/EBufferMapFlags.h>
+#include <baregl/types/EBufferStorageFlags.h>
 #include <baregl/types/EBufferType.h>
+#include <baregl/BufferMapping.h>
 
 #include <optional>
 
@@ -39,12 +42,93 @@ namespace baregl
 		*/
 		uint64_t Allocate(uint64_t p_size, types::EAccessSpecifier p_usage = types::EAccessSpecifier::STATIC_DRAW);
 
+		/**
+		* Allocates immutable storage for the buffer.
+		* Once allocated, the buffer storage can neither be resized nor reallocated.
+		* @note Uploading to an immutable buffer requires the DYNAMIC_STORAGE flag
+		* @param p_size
+		* @param p_flags Intended usage of the storage
+		* @param p_data (Optional) Initial content of the buffer
+		* @return The size of the allocated memory in bytes
+		*/
+		uint64_t Allocate(uint64_t p_size, types::EBufferStorageFlags p_flags, const void* p_data = nullptr);
+
 		/**
 		* Uploads data to the buffer
 		* @param p_data
 		* @param p_range
+		* @param p_orphan If true, the whole buffer storage is orphaned before writing, so that the upload doesn't
+		* have to wait for the GPU to be done with the previous content. Content outside of the range becomes undefined.
+		*/
+		void Upload(
+			const void* p_data,
+			std::optional<data::BufferMemoryRange> p_range = std::nullopt,
+			bool p_orphan = false
+		);
+
+		/**
+		* Reads data back from the buffer, blocking until the GPU is done writing to it
+		* @param p_data Destination memory, large enough to hold the range
+		* @param p_range (Optional) Range to read, the whole buffer if not specified
+		*/
+		void Download(void* p_data, std::optional<data::BufferMemoryRange> p_range = std::nullopt) const;
+
+		/**
+		* Copies data from another buffer (or from this buffer) on the GPU
+		* @note Source and destination ranges cannot overlap when copying within the same buffer
+		* @param p_source
+		* @param p_sourceOffset
+		* @param p_destinationOffset
+		* @param p_size
+		*/
+		void CopyFrom(
+			const Buffer& p_source,
+			uint64_t p_sourceOffset,
+			uint64_t p_destinationOffset,
+			uint64_t p_size
+		);
+
+		/**
+		* Fills the buffer with a repeated 32-bit value on the GPU
+		* @note The range offset and size must be multiples of 4 bytes
+		* @param p_range (Optional) Range to fill, the whole buffer if not specified
+		* @param p_value
+		*/
+		void Clear(std::optional<data::BufferMemoryRange> p_range = std::nullopt, uint32_t p_value = 0);
+
+		/**
+		* Invalidates the content of the buffer, letting the driver discard it instead of synchronizing with
+		* pending GPU work on the next write
+		*/
+		void Invalidate();
+
+		/**
+		* Invalidates the content of a range of the buffer
+		* @param p_range
 		*/
-		void Upload(const void* p_data, std::optional<data::BufferMemoryRange> p_range = std::nullopt);
+		void InvalidateRange(data::BufferMemoryRange p_range);
+
+		/**
+		* Maps the whole buffer into client memory
+		* @param p_flags Access and synchronization flags of the mapping
+		* @return The mapping, unmapped when destroyed
+		*/
+		BufferMapping Map(types::EBufferMapFlags p_flags);
+
+		/**
+		* Maps a range of the buffer into client memory
+		* @note Mapping with UNSYNCHRONIZED skips the implicit wait on pending GPU work, synchronization
+		* becomes the caller's responsibility (e.g. using a Fence)
+		* @param p_range Range to map
+		* @param p_flags Access and synchronization flags of the mapping
+		* @return The mapping, unmapped when destroyed
+		*/
+		BufferMapping MapRange(data::BufferMemoryRange p_range, types::EBufferMapFlags p_flags);
+
+		/**
+		* Returns true if the buffer is currently mapped
+		*/
+		bool IsMapped() const;
 
 		/**
 		* Returns true if the buffer is valid (properly allocated)
@@ -61,6 +145,16 @@ namespace baregl
 		*/
 		uint64_t GetSize() const;
 
+		/**
+		* Returns true if the buffer storage is immutable
+		*/
+		bool IsImmutable() const;
+
+		/**
+		* Returns the storage flags of the buffer, or std::nullopt if the buffer storage is mutable
+		*/
+		std::optional<types::EBufferStorageFlags> GetStorageFlags() const;
+
 		/**
 		* Binds the buffer
 		* @param p_type Type of the buffer to bind
@@ -71,6 +165,19 @@ namespace baregl
 			std::optional<uint32_t> p_index = std::nullopt
 		);
 
+		/**
+		* Binds a range of the buffer to an indexed binding point
+		* @note The range offset must respect the alignment required by the target (e.g. UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+		* @param p_type Type of the buffer to bind
+		* @param p_index Index to bind the buffer to
+		* @param p_range Range of the buffer to bind
+		*/
+		void Bind(
+			types::EBufferType p_type,
+			uint32_t p_index,
+			data::BufferMemoryRange p_range
+		);
+
 		/**
 		* Unbinds the buffer
 		*/
@@ -78,7 +185,15 @@ namespace baregl
 
 	protected:
 		uint64_t m_allocatedBytes = 0;
+		types::EAccessSpecifier m_usage = types::EAccessSpecifier::STATIC_DRAW;
+		std::optional<types::EBufferStorageFlags> m_storageFlags = std::nullopt;
 		std::optional<types::EBufferType> m_boundAs = std::nullopt;
 		std::optional<uint32_t> m_bindIndex = std::nullopt;
+
+	private:
+		friend class BufferMapping;
+
+		// Live mapping of the buffer, released if the buffer gets destroyed first
+		BufferMapping* m_mapping = nullptr;
 	};
 }
@@ -0,0 +1,76 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferMemoryRange.h>
+#include <baregl/Buffer.h>
+#include <baregl/BufferMapping.h>
+#include <baregl/Fence.h>
+
+#include <optional>
+
+namespace baregl
+{
+	/**
+	* Represents an asynchronous read of a buffer range.
+	* The range is copied on the GPU into a staging buffer, which can be mapped once the copy is done,
+	* so that the download doesn't stall the pipeline.
+	* The staging buffer is allocated once and reused by every request, so a download object is meant
+	* to be kept around (e.g. one per frame in flight) rather than created for each read.
+	*/
+	class BufferDownload final
+	{
+	public:
+		/**
+		* Creates a download object and its staging buffer
+		* @param p_capacity Size of the staging buffer in bytes (maximum size of a download)
+		*/
+		BufferDownload(uint64_t p_capacity);
+
+		/**
+		* Starts downloading a range of the given buffer, replacing the result of the previous request
+		* @note The source buffer can be modified or destroyed right after, the copy is ordered on the GPU
+		* @note The mapping of the previous result must be released first
+		* @param p_source
+		* @param p_range (Optional) Range to download, the whole buffer if not specified
+		*/
+		void Request(const Buffer& p_source, std::optional<data::BufferMemoryRange> p_range = std::nullopt);
+
+		/**
+		* Returns true if the GPU is done copying the data, without blocking
+		*/
+		bool IsReady() const;
+
+		/**
+		* Blocks until the GPU is done copying the data or the timeout expires
+		* @param p_timeout Timeout in nanoseconds
+		* @return True if the data is ready, false if the timeout expired
+		*/
+		bool Wait(uint64_t p_timeout = Fence::k_infiniteTimeout) const;
+
+		/**
+		* Maps the downloaded data, blocking until it is ready
+		* @return A read-only mapping of the downloaded range
+		*/
+		BufferMapping GetData();
+
+		/**
+		* Returns the size of the last requested download in bytes
+		*/
+		uint64_t GetSize() const;
+
+		/**
+		* Returns the maximum size of a download in bytes
+		*/
+		uint64_t GetCapacity() const;
+
+	private:
+		Buffer m_staging;
+		Fence m_fence;
+		uint64_t m_size = 0;
+	};
+}
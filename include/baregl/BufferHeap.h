@@ -0,0 +1,130 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferMemoryRange.h>
+#include <baregl/types/EBufferStorageFlags.h>
+#include <baregl/Buffer.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+
+namespace baregl
+{
+	/**
+	* Represents a large buffer split into many sub-allocations, used to pack a lot of small
+	* resources (e.g. meshes) into a single GL buffer.
+	* Free space is tracked with a best-fit free list, adjacent free blocks being merged on release.
+	* Fragmentation can be reduced over time by calling Compact, which relocates live allocations.
+	*/
+	class BufferHeap final
+	{
+	public:
+		/**
+		* Called when an allocation gets relocated by Compact, with its previous and new range
+		*/
+		using RelocationCallback = std::function<void(const data::BufferMemoryRange&, const data::BufferMemoryRange&)>;
+
+		/**
+		* Creates a buffer heap
+		* @param p_size Total size of the heap in bytes
+		* @param p_flags Storage flags of the underlying (immutable) buffer
+		*/
+		BufferHeap(
+			uint64_t p_size,
+			types::EBufferStorageFlags p_flags = types::EBufferStorageFlags::DYNAMIC_STORAGE
+		);
+
+		/**
+		* Sub-allocates memory from the heap
+		* @param p_size Size of the allocation in bytes
+		* @param p_alignment Alignment of the returned offset (e.g. the vertex size, or the index size)
+		* @param p_onRelocated (Optional) Callback notified when the allocation is moved by Compact
+		* @return The allocated range, or std::nullopt if no free block is large enough
+		*/
+		std::optional<data::BufferMemoryRange> Allocate(
+			uint64_t p_size,
+			uint64_t p_alignment = 1,
+			RelocationCallback p_onRelocated = nullptr
+		);
+
+		/**
+		* Releases a range previously returned by Allocate
+		* @param p_range
+		*/
+		void Free(const data::BufferMemoryRange& p_range);
+
+		/**
+		* Slides live allocations towards the start of the heap, merging the free space at its end.
+		* Data is moved on the GPU, and the owners are notified of the new ranges through their relocation callback.
+		* Meant to be called once per frame with a small budget, so that compaction is spread over several frames.
+		* @note At least one allocation is moved per call (if any needs to), even if it exceeds the budget
+		* @note The GPU must not be using relocated allocations through their previous range anymore
+		* @note Allocations overlapping their new range are staged through a scratch buffer, kept as large as the largest of them
+		* @param p_byteBudget Maximum number of bytes to move during this call
+		* @return The number of bytes moved
+		*/
+		uint64_t Compact(uint64_t p_byteBudget);
+
+		/**
+		* Returns the underlying buffer
+		*/
+		Buffer& GetBuffer();
+
+		/**
+		* Returns the total size of the heap in bytes
+		*/
+		uint64_t GetSize() const;
+
+		/**
+		* Returns the number of allocated bytes
+		*/
+		uint64_t GetUsedBytes() const;
+
+		/**
+		* Returns the number of free bytes (not necessarily contiguous)
+		*/
+		uint64_t GetFreeBytes() const;
+
+		/**
+		* Returns the size of the largest free block, which is the largest allocation that can succeed
+		*/
+		uint64_t GetLargestFreeBlock() const;
+
+		/**
+		* Returns the number of live allocations
+		*/
+		uint64_t GetAllocationCount() const;
+
+	private:
+		struct Allocation
+		{
+			uint64_t size;
+			uint64_t alignment;
+			RelocationCallback onRelocated;
+		};
+
+		void Claim(uint64_t p_blockOffset, uint64_t p_blockSize, uint64_t p_offset, uint64_t p_size);
+		void Release(uint64_t p_offset, uint64_t p_size);
+		void Move(uint64_t p_from, uint64_t p_to, uint64_t p_size);
+		void AddFreeBlock(uint64_t p_offset, uint64_t p_size);
+		void RemoveFreeBlock(uint64_t p_offset, uint64_t p_size);
+
+	private:
+		Buffer m_buffer;
+		Buffer m_scratchBuffer;
+		uint64_t m_usedBytes = 0;
+
+		// Free blocks indexed by offset (to merge neighbours) and by size (for best-fit lookups)
+		std::map<uint64_t, uint64_t> m_freeBlocksByOffset;
+		std::multimap<uint64_t, uint64_t> m_freeBlocksBySize;
+
+		// Live allocations, indexed by offset
+		std::map<uint64_t, Allocation> m_allocations;
+	};
+}
@@ -0,0 +1,116 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferMemoryRange.h>
+#include <baregl/types/EBufferMapFlags.h>
+
+#include <cstddef>
+#include <span>
+
+namespace baregl
+{
+	class Buffer;
+
+	/**
+	* Represents a range of a buffer mapped into client memory.
+	* The range is unmapped when the mapping is destroyed.
+	* A buffer destroyed while mapped releases its mapping, which then becomes empty (see IsMapped).
+	*/
+	class BufferMapping final
+	{
+	public:
+		/**
+		* Unmaps the buffer range (if still mapped)
+		*/
+		~BufferMapping();
+
+		/**
+		* Deleted copy constructor
+		*/
+		BufferMapping(const BufferMapping&) = delete;
+
+		/**
+		* Deleted copy assignment operator
+		*/
+		BufferMapping& operator=(const BufferMapping&) = delete;
+
+		/**
+		* Move constructor
+		* @param p_other
+		*/
+		BufferMapping(BufferMapping&& p_other) noexcept;
+
+		/**
+		* Move assignment operator
+		* @param p_other
+		*/
+		BufferMapping& operator=(BufferMapping&& p_other) noexcept;
+
+		/**
+		* Returns the mapped memory, viewed as an array of T
+		* @note Trailing bytes that don't fit in a whole T are not part of the returned view
+		*/
+		template<typename T = std::byte>
+		std::span<T> GetData() const
+		{
+			return { reinterpret_cast<T*>(m_data.data()), m_data.size_bytes() / sizeof(T) };
+		}
+
+		/**
+		* Makes the writes to the given range visible to the GPU
+		* @note Only applicable to mappings created with the FLUSH_EXPLICIT flag
+		* @param p_range Range to flush, relative to the start of the mapping
+		*/
+		void FlushRange(data::BufferMemoryRange p_range);
+
+		/**
+		* Makes the writes to the whole mapping visible to the GPU
+		* @note Only applicable to mappings created with the FLUSH_EXPLICIT flag
+		*/
+		void Flush();
+
+		/**
+		* Unmaps the buffer range before the mapping gets destroyed
+		*/
+		void Unmap();
+
+		/**
+		* Returns true if the buffer range is still mapped
+		*/
+		bool IsMapped() const;
+
+		/**
+		* Returns the mapped range, relative to the start of the buffer
+		*/
+		data::BufferMemoryRange GetRange() const;
+
+		/**
+		* Returns the flags used to create the mapping
+		*/
+		types::EBufferMapFlags GetFlags() const;
+
+	private:
+		friend class Buffer;
+
+		BufferMapping(
+			Buffer& p_buffer,
+			std::span<std::byte> p_data,
+			uint64_t p_offset,
+			types::EBufferMapFlags p_flags
+		);
+
+		// Detaches the mapping from its buffer, without unmapping it
+		void Release();
+
+	private:
+		Buffer* m_buffer;
+		std::span<std::byte> m_data;
+		uint64_t m_offset;
+		types::EBufferMapFlags m_flags;
+	};
+}
@@ -0,0 +1,258 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferMemoryRange.h>
+#include <baregl/types/EBlendingFactor.h>
+#include <baregl/types/EBufferType.h>
+#include <baregl/types/EComparaisonAlgorithm.h>
+#include <baregl/types/ECullFace.h>
+#include <baregl/types/EIndexType.h>
+#include <baregl/types/EMemoryBarrierFlags.h>
+#include <baregl/types/EPrimitiveMode.h>
+#include <baregl/types/ERenderingCapability.h>
+#include <baregl/ShaderProgram.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace baregl
+{
+	class Buffer;
+	class Context;
+	class Texture;
+	class VertexArray;
+
+	/**
+	* Records binds, state changes, uniform updates and draws into a linear memory arena, without issuing any GL call.
+	* Command lists can be recorded on worker threads and replayed later on the thread owning the GL context.
+	* @note A command list must only be recorded by one thread at a time, and every recorded object must stay alive until replayed
+	*/
+	class CommandList final
+	{
+	public:
+		/**
+		* Creates an empty command list
+		* @param p_reservedBytes Number of bytes to preallocate for the arena
+		*/
+		CommandList(uint64_t p_reservedBytes = 0);
+
+		/**
+		* Records a shader program bind
+		* @param p_program
+		*/
+		void BindProgram(const ShaderProgram& p_program);
+
+		/**
+		* Records a vertex array bind
+		* @param p_vertexArray
+		*/
+		void BindVertexArray(const VertexArray& p_vertexArray);
+
+		/**
+		* Records a texture bind
+		* @param p_texture
+		* @param p_slot
+		*/
+		void BindTexture(const Texture& p_texture, uint32_t p_slot);
+
+		/**
+		* Records a buffer bind
+		* @param p_buffer
+		* @param p_type Type of the buffer to bind
+		* @param p_index (Optional) Index to bind the buffer to
+		*/
+		void BindBuffer(Buffer& p_buffer, types::EBufferType p_type, std::optional<uint32_t> p_index = std::nullopt);
+
+		/**
+		* Records a buffer range bind to an indexed binding point
+		* @param p_buffer
+		* @param p_type Type of the buffer to bind
+		* @param p_index Index to bind the buffer to
+		* @param p_range Range of the buffer to bind
+		*/
+		void BindBuffer(Buffer& p_buffer, types::EBufferType p_type, uint32_t p_index, data::BufferMemoryRange p_range);
+
+		/**
+		* Records a uniform update for the given program
+		* @note The uniform location is resolved while recording, unknown uniforms are ignored
+		* @note The value is sent to the given program, whichever program is bound when the command is replayed
+		* @param p_program
+		* @param p_name
+		* @param p_value
+		*/
+		template<SupportedUniformType T>
+		void SetUniform(ShaderProgram& p_program, const std::string& p_name, const T& p_value);
+
+		/**
+		* Records a capability change
+		* @param p_capability
+		* @param p_value
+		*/
+		void SetCapability(types::ERenderingCapability p_capability, bool p_value);
+
+		/**
+		* Records a depth test function change
+		* @param p_algorithm
+		*/
+		void SetDepthAlgorithm(types::EComparaisonAlgorithm p_algorithm);
+
+		/**
+		* Records a depth writing change
+		* @param p_enable
+		*/
+		void SetDepthWriting(bool p_enable);
+
+		/**
+		* Records a color writing change
+		* @param p_enableRed
+		* @param p_enableGreen
+		* @param p_enableBlue
+		* @param p_enableAlpha
+		*/
+		void SetColorWriting(bool p_enableRed, bool p_enableGreen, bool p_enableBlue, bool p_enableAlpha);
+
+		/**
+		* Records a blending function change
+		* @param p_sourceFactor
+		* @param p_destinationFactor
+		*/
+		void SetBlendingFunction(types::EBlendingFactor p_sourceFactor, types::EBlendingFactor p_destinationFactor);
+
+		/**
+		* Records a culled face change
+		* @param p_cullFace
+		*/
+		void SetCullFace(types::ECullFace p_cullFace);
+
+		/**
+		* Records a viewport change
+		* @param p_x
+		* @param p_y
+		* @param p_width
+		* @param p_height
+		*/
+		void SetViewport(uint32_t p_x, uint32_t p_y, uint32_t p_width, uint32_t p_height);
+
+		/**
+		* Records a clear color change
+		* @param p_red
+		* @param p_green
+		* @param p_blue
+		* @param p_alpha
+		*/
+		void SetClearColor(float p_red, float p_green, float p_blue, float p_alpha);
+
+		/**
+		* Records a clear of the bound framebuffer
+		* @param p_colorBuffer
+		* @param p_depthBuffer
+		* @param p_stencilBuffer
+		*/
+		void Clear(bool p_colorBuffer, bool p_depthBuffer, bool p_stencilBuffer);
+
+		/**
+		* Records an indexed draw (see Context::DrawElementsInstanced)
+		* @param p_primitiveMode
+		* @param p_indexCount
+		* @param p_indexType
+		* @param p_instances
+		* @param p_firstIndex
+		* @param p_baseVertex
+		* @param p_baseInstance
+		*/
+		void DrawElements(
+			types::EPrimitiveMode p_primitiveMode,
+			uint32_t p_indexCount,
+			types::EIndexType p_indexType = types::EIndexType::UNSIGNED_INT,
+			uint32_t p_instances = 1,
+			uint32_t p_firstIndex = 0,
+			int32_t p_baseVertex = 0,
+			uint32_t p_baseInstance = 0
+		);
+
+		/**
+		* Records a non-indexed draw (see Context::DrawArraysInstanced)
+		* @param p_primitiveMode
+		* @param p_vertexCount
+		* @param p_instances
+		* @param p_firstVertex
+		* @param p_baseInstance
+		*/
+		void DrawArrays(
+			types::EPrimitiveMode p_primitiveMode,
+			uint32_t p_vertexCount,
+			uint32_t p_instances = 1,
+			uint32_t p_firstVertex = 0,
+			uint32_t p_baseInstance = 0
+		);
+
+		/**
+		* Records an indirect multi-draw (see Context::MultiDrawElementsIndirect)
+		* @param p_primitiveMode
+		* @param p_commandBuffer
+		* @param p_drawCount
+		* @param p_offset
+		* @param p_stride
+		* @param p_indexType
+		*/
+		void MultiDrawElementsIndirect(
+			types::EPrimitiveMode p_primitiveMode,
+			const Buffer& p_commandBuffer,
+			uint32_t p_drawCount,
+			uint64_t p_offset = 0,
+			uint32_t p_stride = 0,
+			types::EIndexType p_indexType = types::EIndexType::UNSIGNED_INT
+		);
+
+		/**
+		* Records a compute dispatch
+		* @param p_x
+		* @param p_y
+		* @param p_z
+		*/
+		void DispatchCompute(uint32_t p_x, uint32_t p_y = 1, uint32_t p_z = 1);
+
+		/**
+		* Records a memory barrier
+		* @param p_barriers
+		*/
+		void MemoryBarrier(types::EMemoryBarrierFlags p_barriers);
+
+		/**
+		* Replays the recorded commands, in order
+		* @note Must be called from the thread owning the GL context. The list is left untouched and can be replayed again
+		* @param p_context
+		*/
+		void Execute(Context& p_context) const;
+
+		/**
+		* Discards all the recorded commands, keeping the arena memory for reuse
+		*/
+		void Reset();
+
+		/**
+		* Returns true if no command has been recorded
+		*/
+		bool IsEmpty() const;
+
+		/**
+		* Returns the number of recorded commands
+		*/
+		uint32_t GetCommandCount() const;
+
+		/**
+		* Returns the number of bytes used by the recorded commands
+		*/
+		uint64_t GetSize() const;
+
+	private:
+		std::vector<std::byte> m_arena;
+		uint32_t m_commandCount = 0;
+	};
+}
@@ -6,12 +6,19 @@
 
 #pragma once
 
+#include <baregl/data/BufferBinding.h>
+#include <baregl/data/DispatchIndirectCommand.h>
+#include <baregl/data/DrawArraysIndirectCommand.h>
+#include <baregl/data/DrawElementsIndirectCommand.h>
 #include <baregl/data/GetResult.h>
+#include <baregl/data/StateCacheStatistics.h>
 #include <baregl/types/EBlendingEquation.h>
 #include <baregl/types/EBlendingFactor.h>
+#include <baregl/types/EBufferType.h>
 #include <baregl/types/EComparaisonAlgorithm.h>
 #include <baregl/types/ECullFace.h>
 #include <baregl/types/EGetParameter.h>
+#include <baregl/types/EIndexType.h>
 #include <baregl/types/EMemoryBarrierFlags.h>
 #include <baregl/types/EOperation.h>
 #include <baregl/types/EPixelDataFormat.h>
@@ -20,8 +27,13 @@
 #include <baregl/types/ERasterizationMode.h>
 #include <baregl/types/ERenderingCapability.h>
 
+#include <span>
+
 namespace baregl
 {
+	class Buffer;
+	class PipelineState;
+
 	/**
 	* Manages BareGL state for the currently active OpenGL context.
 	*/
@@ -74,6 +86,22 @@ namespace baregl
 		*/
 		void DrawElements(types::EPrimitiveMode p_primitiveMode, uint32_t p_indexCount);
 
+		/**
+		* Renders primitives from array data, with explicit index type and offsets.
+		* @param p_primitiveMode Specifies the kind of primitives to render.
+		* @param p_indexCount The number of elements to render.
+		* @param p_indexType The type of the values in the index buffer.
+		* @param p_firstIndex The position of the first index to read in the index buffer.
+		* @param p_baseVertex A constant added to each index when fetching vertices.
+		*/
+		void DrawElements(
+			types::EPrimitiveMode p_primitiveMode,
+			uint32_t p_indexCount,
+			types::EIndexType p_indexType,
+			uint32_t p_firstIndex = 0,
+			int32_t p_baseVertex = 0
+		);
+
 		/**
 		* Renders multiple instances of a set of elements.
 		* @param p_primitiveMode Specifies the kind of primitives to render.
@@ -82,20 +110,136 @@ namespace baregl
 		*/
 		void DrawElementsInstanced(types::EPrimitiveMode p_primitiveMode, uint32_t p_indexCount, uint32_t p_instances);
 
+		/**
+		* Renders multiple instances of a set of elements, with explicit index type and offsets.
+		* @param p_primitiveMode Specifies the kind of primitives to render.
+		* @param p_indexCount The number of elements to render.
+		* @param p_instances The number of instances to render.
+		* @param p_indexType The type of the values in the index buffer.
+		* @param p_firstIndex The position of the first index to read in the index buffer.
+		* @param p_baseVertex A constant added to each index when fetching vertices.
+		* @param p_baseInstance The base instance for use in fetching instanced vertex attributes.
+		*/
+		void DrawElementsInstanced(
+			types::EPrimitiveMode p_primitiveMode,
+			uint32_t p_indexCount,
+			uint32_t p_instances,
+			types::EIndexType p_indexType,
+			uint32_t p_firstIndex = 0,
+			int32_t p_baseVertex = 0,
+			uint32_t p_baseInstance = 0
+		);
+
 		/**
 		* Renders primitives from array data without indexing.
 		* @param p_primitiveMode Specifies the kind of primitives to render.
 		* @param p_vertexCount The number of vertices to render.
+		* @param p_firstVertex The index of the first vertex to render.
 		*/
-		void DrawArrays(types::EPrimitiveMode p_primitiveMode, uint32_t p_vertexCount);
+		void DrawArrays(types::EPrimitiveMode p_primitiveMode, uint32_t p_vertexCount, uint32_t p_firstVertex = 0);
 
 		/**
 		* Renders multiple instances of a set of vertices.
 		* @param p_primitiveMode Specifies the kind of primitives to render.
 		* @param p_vertexCount The number of vertices to render.
 		* @param p_instances The number of instances to render.
+		* @param p_firstVertex The index of the first vertex to render.
+		* @param p_baseInstance The base instance for use in fetching instanced vertex attributes.
 		*/
-		void DrawArraysInstanced(types::EPrimitiveMode p_primitiveMode, uint32_t p_vertexCount, uint32_t p_instances);
+		void DrawArraysInstanced(
+			types::EPrimitiveMode p_primitiveMode,
+			uint32_t p_vertexCount,
+			uint32_t p_instances,
+			uint32_t p_firstVertex = 0,
+			uint32_t p_baseInstance = 0
+		);
+
+		/**
+		* Renders multiple sets of elements, with draw parameters sourced from a buffer.
+		* @note EBufferType::DRAW_INDIRECT is unbound afterwards
+		* @param p_primitiveMode Specifies the kind of primitives to render.
+		* @param p_commandBuffer Buffer containing data::DrawElementsIndirectCommand entries.
+		* @param p_drawCount The number of draws to issue.
+		* @param p_offset Offset of the first command in the buffer, in bytes.
+		* @param p_stride Distance between two commands in bytes (0 means tightly packed).
+		* @param p_indexType The type of the values in the index buffer.
+		*/
+		void MultiDrawElementsIndirect(
+			types::EPrimitiveMode p_primitiveMode,
+			const Buffer& p_commandBuffer,
+			uint32_t p_drawCount,
+			uint64_t p_offset = 0,
+			uint32_t p_stride = 0,
+			types::EIndexType p_indexType = types::EIndexType::UNSIGNED_INT
+		);
+
+		/**
+		* Renders multiple sets of elements, with draw parameters and draw count sourced from buffers.
+		* @note Requires GL_ARB_indirect_parameters (see IsIndirectCountSupported)
+		* @note EBufferType::DRAW_INDIRECT and EBufferType::PARAMETER are unbound afterwards
+		* @param p_primitiveMode Specifies the kind of primitives to render.
+		* @param p_commandBuffer Buffer containing data::DrawElementsIndirectCommand entries.
+		* @param p_countBuffer Buffer containing the number of draws to issue, as a uint32_t.
+		* @param p_countOffset Offset of the draw count in the count buffer, in bytes.
+		* @param p_maxDrawCount Upper bound of the number of draws to issue.
+		* @param p_offset Offset of the first command in the buffer, in bytes.
+		* @param p_stride Distance between two commands in bytes (0 means tightly packed).
+		* @param p_indexType The type of the values in the index buffer.
+		*/
+		void MultiDrawElementsIndirectCount(
+			types::EPrimitiveMode p_primitiveMode,
+			const Buffer& p_commandBuffer,
+			const Buffer& p_countBuffer,
+			uint64_t p_countOffset,
+			uint32_t p_maxDrawCount,
+			uint64_t p_offset = 0,
+			uint32_t p_stride = 0,
+			types::EIndexType p_indexType = types::EIndexType::UNSIGNED_INT
+		);
+
+		/**
+		* Renders multiple sets of vertices, with draw parameters sourced from a buffer.
+		* @note EBufferType::DRAW_INDIRECT is unbound afterwards
+		* @param p_primitiveMode Specifies the kind of primitives to render.
+		* @param p_commandBuffer Buffer containing data::DrawArraysIndirectCommand entries.
+		* @param p_drawCount The number of draws to issue.
+		* @param p_offset Offset of the first command in the buffer, in bytes.
+		* @param p_stride Distance between two commands in bytes (0 means tightly packed).
+		*/
+		void MultiDrawArraysIndirect(
+			types::EPrimitiveMode p_primitiveMode,
+			const Buffer& p_commandBuffer,
+			uint32_t p_drawCount,
+			uint64_t p_offset = 0,
+			uint32_t p_stride = 0
+		);
+
+		/**
+		* Renders multiple sets of vertices, with draw parameters and draw count sourced from buffers.
+		* @note Requires GL_ARB_indirect_parameters (see IsIndirectCountSupported)
+		* @note EBufferType::DRAW_INDIRECT and EBufferType::PARAMETER are unbound afterwards
+		* @param p_primitiveMode Specifies the kind of primitives to render.
+		* @param p_commandBuffer Buffer containing data::DrawArraysIndirectCommand entries.
+		* @param p_countBuffer Buffer containing the number of draws to issue, as a uint32_t.
+		* @param p_countOffset Offset of the draw count in the count buffer, in bytes.
+		* @param p_maxDrawCount Upper bound of the number of draws to issue.
+		* @param p_offset Offset of the first command in the buffer, in bytes.
+		* @param p_stride Distance between two commands in bytes (0 means tightly packed).
+		*/
+		void MultiDrawArraysIndirectCount(
+			types::EPrimitiveMode p_primitiveMode,
+			const Buffer& p_commandBuffer,
+			const Buffer& p_countBuffer,
+			uint64_t p_countOffset,
+			uint32_t p_maxDrawCount,
+			uint64_t p_offset = 0,
+			uint32_t p_stride = 0
+		);
+
+		/**
+		* Returns true if draws can source their draw count from a buffer (GL_ARB_indirect_parameters).
+		*/
+		bool IsIndirectCountSupported() const;
 
 		/**
 		* Dispatches the current active program for execution.
@@ -106,6 +250,15 @@ namespace baregl
 		*/
 		void DispatchCompute(uint32_t p_x, uint32_t p_y, uint32_t p_z) const;
 
+		/**
+		* Dispatches the current active program for execution, with work group counts sourced from a buffer.
+		* @note only applicable for compute shaders.
+		* @note EBufferType::DISPATCH_INDIRECT is unbound afterwards
+		* @param p_commandBuffer Buffer containing a data::DispatchIndirectCommand.
+		* @param p_offset Offset of the command in the buffer, in bytes.
+		*/
+		void DispatchComputeIndirect(const Buffer& p_commandBuffer, uint64_t p_offset = 0) const;
+
 		/**
 		* Enables OpenGL debug message streams.
 		*/
@@ -123,6 +276,19 @@ namespace baregl
 		*/
 		void MemoryBarrier(types::EMemoryBarrierFlags p_barriers) const;
 
+		/**
+		* Binds ranges of buffers to a contiguous span of indexed binding points, in a single call.
+		* @note At most 96 buffers can be bound per call
+		* @param p_type Type of the binding points (e.g. UNIFORM, SHADER_STORAGE)
+		* @param p_firstIndex Index of the first binding point
+		* @param p_bindings Buffer ranges to bind, the i-th one going to p_firstIndex + i
+		*/
+		void BindBuffersRange(
+			types::EBufferType p_type,
+			uint32_t p_firstIndex,
+			std::span<const data::BufferBinding> p_bindings
+		);
+
 		/**
 		* Sets the clear color for the color buffer.
 		* @param p_red The red component of the clear color.
@@ -238,6 +404,29 @@ namespace baregl
 		*/
 		void SetViewport(uint32_t p_x, uint32_t p_y, uint32_t p_width, uint32_t p_height);
 
+		/**
+		* Applies the given pipeline state, only issuing GL calls for the states that differ from the current ones.
+		* @note Applying the pipeline state that is already in place doesn't issue any call.
+		* @param p_pipelineState The pipeline state to apply.
+		*/
+		void SetPipelineState(const PipelineState& p_pipelineState);
+
+		/**
+		* Marks the whole shadowed state as unknown, so that the next state calls are forwarded to the driver.
+		* Must be called after GL state has been modified outside of BareGL (e.g. by a third-party library).
+		*/
+		void InvalidateStateCache();
+
+		/**
+		* Returns the number of state calls submitted to the driver and elided by the state cache.
+		*/
+		data::StateCacheStatistics GetStateCacheStatistics() const;
+
+		/**
+		* Resets the state cache statistics.
+		*/
+		void ResetStateCacheStatistics();
+
 		/**
 		* Returns the value or values for a given parameter
 		* @return Query result
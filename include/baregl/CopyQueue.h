@@ -0,0 +1,65 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferCopyRegion.h>
+#include <baregl/Buffer.h>
+
+#include <vector>
+
+namespace baregl
+{
+	/**
+	* Collects buffer-to-buffer copies and submits them together.
+	* On submission, copies are sorted and contiguous ones are merged into a single GPU copy.
+	* @note Copies in the same batch are not ordered, so they shouldn't write to overlapping ranges
+	*/
+	class CopyQueue final
+	{
+	public:
+		/**
+		* Queues a copy
+		* @note Both buffers must stay alive until the queue is submitted
+		* @param p_source
+		* @param p_destination
+		* @param p_region
+		*/
+		void Enqueue(const Buffer& p_source, Buffer& p_destination, const data::BufferCopyRegion& p_region);
+
+		/**
+		* Issues all the queued copies and empties the queue
+		* @return The number of copy commands issued
+		*/
+		uint32_t Submit();
+
+		/**
+		* Discards all the queued copies
+		*/
+		void Reset();
+
+		/**
+		* Returns the number of queued copies
+		*/
+		uint32_t GetPendingCount() const;
+
+		/**
+		* Returns the number of bytes queued for copy
+		*/
+		uint64_t GetPendingBytes() const;
+
+	private:
+		struct Copy
+		{
+			const Buffer* source;
+			Buffer* destination;
+			data::BufferCopyRegion region;
+		};
+
+		std::vector<Copy> m_copies;
+		uint64_t m_pendingBytes = 0;
+	};
+}
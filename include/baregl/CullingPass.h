@@ -0,0 +1,82 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BoundingSphere.h>
+#include <baregl/data/DrawElementsIndirectCommand.h>
+#include <baregl/math/Mat4.h>
+#include <baregl/Buffer.h>
+#include <baregl/Context.h>
+#include <baregl/ShaderProgram.h>
+#include <baregl/ShaderStage.h>
+#include <baregl/Texture.h>
+
+#include <functional>
+#include <optional>
+
+namespace baregl
+{
+	/**
+	* Culls instances on the GPU against the view frustum, and optionally against a depth pyramid (Hi-Z).
+	* Outputs the draw commands of the visible instances, compacted, along with their count, to be consumed
+	* by Context::MultiDrawElementsIndirectCount (or read back).
+	*/
+	class CullingPass final
+	{
+	public:
+		/**
+		* Creates a culling pass
+		* @param p_maxInstanceCount Maximum number of instances that can be culled at once
+		*/
+		CullingPass(uint32_t p_maxInstanceCount);
+
+		/**
+		* Culls the given instances
+		* @note Each visible instance outputs its draw command with baseInstance set to the instance index,
+		* so that instanced vertex attributes (or gl_BaseInstance) fetch the data of that instance
+		* @param p_context
+		* @param p_bounds Buffer containing one data::BoundingSphere per instance
+		* @param p_drawCommands Buffer containing one data::DrawElementsIndirectCommand per instance
+		* @param p_instanceCount Number of instances to cull
+		* @param p_viewProjection View-projection matrix used to render the instances
+		* @param p_depthPyramid (Optional) Mipmapped depth texture where each texel holds the farthest depth of
+		* the texels it covers in the previous level, used for occlusion culling. Texels are fetched directly, so its
+		* filtering mode doesn't matter
+		*/
+		void Execute(
+			Context& p_context,
+			const Buffer& p_bounds,
+			const Buffer& p_drawCommands,
+			uint32_t p_instanceCount,
+			const math::Mat4& p_viewProjection,
+			std::optional<std::reference_wrapper<const Texture>> p_depthPyramid = std::nullopt
+		);
+
+		/**
+		* Returns the buffer containing the compacted draw commands of the visible instances
+		*/
+		const Buffer& GetCommandBuffer() const;
+
+		/**
+		* Returns the buffer containing the number of visible instances, as a uint32_t
+		*/
+		const Buffer& GetCountBuffer() const;
+
+		/**
+		* Returns the maximum number of instances that can be culled at once
+		*/
+		uint32_t GetMaxInstanceCount() const;
+
+	private:
+		ShaderStage m_shader;
+		ShaderProgram m_program;
+		Buffer m_commandBuffer;
+		Buffer m_countBuffer;
+		const uint32_t m_maxInstanceCount;
+		uint32_t m_workGroupSize = 0;
+	};
+}
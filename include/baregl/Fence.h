@@ -0,0 +1,87 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace baregl
+{
+	/**
+	* Represents a fence sync object, used to know when the GPU is done with the commands issued before it
+	*/
+	class Fence final
+	{
+	public:
+		static constexpr uint64_t k_infiniteTimeout = std::numeric_limits<uint64_t>::max();
+
+		/**
+		* Creates an empty fence (considered signaled until inserted)
+		*/
+		Fence() = default;
+
+		/**
+		* Destroys the fence
+		*/
+		~Fence();
+
+		/**
+		* Deleted copy constructor
+		*/
+		Fence(const Fence&) = delete;
+
+		/**
+		* Deleted copy assignment operator
+		*/
+		Fence& operator=(const Fence&) = delete;
+
+		/**
+		* Move constructor
+		* @param p_other
+		*/
+		Fence(Fence&& p_other) noexcept;
+
+		/**
+		* Move assignment operator
+		* @param p_other
+		*/
+		Fence& operator=(Fence&& p_other) noexcept;
+
+		/**
+		* Inserts the fence in the command stream, replacing any previously inserted fence
+		*/
+		void Insert();
+
+		/**
+		* Releases the underlying sync object
+		*/
+		void Reset();
+
+		/**
+		* Returns true if the fence has been inserted and hasn't been reset since
+		*/
+		bool IsInserted() const;
+
+		/**
+		* Returns true if the GPU has reached the fence, without blocking
+		* @note An empty fence is always considered signaled
+		*/
+		bool IsSignaled() const;
+
+		/**
+		* Blocks until the GPU reaches the fence or the timeout expires
+		* @note An empty fence is always considered signaled
+		* @param p_timeout Timeout in nanoseconds
+		* @return True if the fence has been signaled, false if the timeout expired
+		*/
+		bool Wait(uint64_t p_timeout = k_infiniteTimeout) const;
+
+	private:
+		// Opaque GLsync handle, kept untyped so that no GL header leaks into the public API
+		void* m_sync = nullptr;
+	};
+}
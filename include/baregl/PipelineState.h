@@ -0,0 +1,55 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/PipelineStateDesc.h>
+
+#include <cstdint>
+
+namespace baregl
+{
+	/**
+	* Immutable bundle of fixed-function state, applied at once with Context::SetPipelineState.
+	* Descriptions are interned on creation: pipeline states created from equal descriptions share the same ID,
+	* which lets the context skip re-applying a pipeline state that is already in place.
+	*/
+	class PipelineState final
+	{
+	public:
+		/**
+		* Creates a pipeline state from the given description
+		* @param p_desc
+		*/
+		PipelineState(const data::PipelineStateDesc& p_desc = {});
+
+		/**
+		* Returns the description of the pipeline state
+		*/
+		const data::PipelineStateDesc& GetDesc() const;
+
+		/**
+		* Returns the hash of the description
+		*/
+		uint64_t GetHash() const;
+
+		/**
+		* Returns the interned ID of the description, shared by every pipeline state created from an equal description
+		*/
+		uint32_t GetID() const;
+
+		/**
+		* Returns true if both pipeline states were created from equal descriptions
+		* @param p_other
+		*/
+		bool operator==(const PipelineState& p_other) const;
+
+	private:
+		data::PipelineStateDesc m_desc;
+		uint64_t m_hash;
+		uint32_t m_id;
+	};
+}
@@ -0,0 +1,87 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/DrawPacket.h>
+
+#include <vector>
+
+namespace baregl
+{
+	class Context;
+
+	/**
+	* Collects draw packets and submits them ordered by a 64 bits sort key, so that state changes are minimized.
+	* From the most to the least significant bits, the key is made of: pass, program, pipeline state, vertex array, first texture and depth.
+	* Keys are sorted with a LSD radix sort.
+	* Packets don't inherit state from the ones submitted before them: a packet without pipeline state is drawn
+	* with the default one (see data::PipelineStateDesc), and its empty texture slots are unbound.
+	*/
+	class RenderQueue final
+	{
+	public:
+		/**
+		* Creates a render queue
+		* @param p_reservedPackets Number of packets to preallocate memory for
+		*/
+		RenderQueue(uint32_t p_reservedPackets = 0);
+
+		/**
+		* Queues a draw packet
+		* @note Every object referenced by the packet must stay alive until the queue is submitted
+		* @param p_packet
+		*/
+		void Enqueue(const data::DrawPacket& p_packet);
+
+		/**
+		* Sorts the queued packets, then issues them, only binding what changed between two consecutive packets
+		* @param p_context
+		* @return The number of draw calls issued
+		*/
+		uint32_t Submit(Context& p_context);
+
+		/**
+		* Sorts the queued packets without submitting them (already done by Submit)
+		*/
+		void Sort();
+
+		/**
+		* Discards all the queued packets
+		*/
+		void Reset();
+
+		/**
+		* Returns the number of queued packets
+		*/
+		uint32_t GetPendingCount() const;
+
+		/**
+		* Returns the sort key of the pending packet at the given position in the submission order
+		* @note The order is only defined once the queue has been sorted (see Sort)
+		* @param p_index
+		*/
+		uint64_t GetPendingKey(uint32_t p_index) const;
+
+		/**
+		* Returns the sort key of the given packet
+		* @param p_packet
+		*/
+		static uint64_t CalculateSortKey(const data::DrawPacket& p_packet);
+
+	private:
+		struct Entry
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		std::vector<data::DrawPacket> m_packets;
+		std::vector<Entry> m_entries;
+		std::vector<Entry> m_scratch;
+		bool m_sorted = true;
+	};
+}
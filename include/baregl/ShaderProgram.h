@@ -16,6 +16,7 @@
 #include <baregl/math/Vec4.h>
 #include <baregl/ShaderStage.h>
 
+#include <array>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -91,6 +92,15 @@ namespace baregl
 		template<SupportedUniformType T>
 		void SetUniform(const std::string& p_name, const T& p_value);
 
+		/**
+		* Sends a uniform value to the given location.
+		* @note The value is sent to this program directly, which doesn't need to be bound
+		* @param p_location Location previously returned by GetUniformLocation
+		* @param p_value
+		*/
+		template<SupportedUniformType T>
+		void SetUniform(uint32_t p_location, const T& p_value);
+
 		/**
 		* Returns the value of a uniform associated with the given name.
 		* @note The shader program must be bound before calling GetUniform
@@ -106,11 +116,33 @@ namespace baregl
 		*/
 		std::optional<std::reference_wrapper<const data::UniformInfo>> GetUniformInfo(const std::string& p_name) const;
 
+		/**
+		* Returns the location of the uniform identified by the given name or std::nullopt if not found.
+		* @note Doesn't issue any GL call, so it can be used from any thread once the program is linked
+		* @param p_name
+		*/
+		std::optional<uint32_t> GetUniformLocation(const std::string& p_name) const;
+
 		/**
 		* Returns the uniforms associated with this program.
 		*/
 		const std::unordered_map<std::string, data::UniformInfo>& GetUniforms() const;
 
+		/**
+		* Returns the local work group size declared by the compute shader of the program.
+		* @note The program must be linked and contain a compute shader
+		*/
+		std::array<uint32_t, 3> GetComputeWorkGroupSize() const;
+
+		/**
+		* Returns the number of work groups required to process the given number of elements in each dimension.
+		* @note The program must be linked and contain a compute shader
+		* @param p_x Number of elements in the X dimension
+		* @param p_y Number of elements in the Y dimension
+		* @param p_z Number of elements in the Z dimension
+		*/
+		std::array<uint32_t, 3> GetComputeWorkGroupCount(uint32_t p_x, uint32_t p_y = 1, uint32_t p_z = 1) const;
+
 	private:
 		void QueryUniforms();
 
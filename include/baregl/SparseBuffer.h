@@ -0,0 +1,105 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferBinding.h>
+#include <baregl/data/BufferMemoryRange.h>
+#include <baregl/Buffer.h>
+
+#include <memory>
+#include <vector>
+
+namespace baregl
+{
+	/**
+	* Represents a buffer with a large virtual address space, where memory is only committed for the pages in use.
+	* Relies on GL_ARB_sparse_buffer. When the extension isn't supported, falls back to one regular buffer
+	* per committed page, so that memory still follows the committed pages. Pages are then backed by distinct
+	* buffers, and ranges must be resolved to their backing buffer (see Resolve) before being bound.
+	*/
+	class SparseBuffer final
+	{
+	public:
+		/**
+		* Creates a sparse buffer, without committing any memory
+		* @param p_size Virtual size of the buffer in bytes (rounded up to the page size)
+		* @param p_useExtension Set to false to use the fallback even if GL_ARB_sparse_buffer is supported
+		*/
+		SparseBuffer(uint64_t p_size, bool p_useExtension = true);
+
+		/**
+		* Commits memory for the pages covering the given range
+		* @param p_range
+		*/
+		void Commit(data::BufferMemoryRange p_range);
+
+		/**
+		* Releases the memory of the pages covering the given range, their content becoming undefined
+		* @param p_range
+		*/
+		void Decommit(data::BufferMemoryRange p_range);
+
+		/**
+		* Returns true if all the pages covering the given range are committed
+		* @param p_range
+		*/
+		bool IsCommitted(data::BufferMemoryRange p_range) const;
+
+		/**
+		* Uploads data to a committed range, which can span several pages
+		* @param p_data
+		* @param p_range
+		*/
+		void Upload(const void* p_data, data::BufferMemoryRange p_range);
+
+		/**
+		* Returns the buffer backing the given committed range, and the location of the range in that buffer
+		* @note With the fallback, the range must not cross a page boundary
+		* @param p_range
+		*/
+		data::BufferBinding Resolve(data::BufferMemoryRange p_range) const;
+
+		/**
+		* Returns true if the buffer relies on GL_ARB_sparse_buffer, false if it uses the fallback
+		*/
+		bool IsSparse() const;
+
+		/**
+		* Returns the underlying buffer
+		* @note Only available if the buffer relies on GL_ARB_sparse_buffer
+		*/
+		Buffer& GetBuffer();
+
+		/**
+		* Returns the page size in bytes, which is the commitment granularity
+		*/
+		uint64_t GetPageSize() const;
+
+		/**
+		* Returns the virtual size of the buffer in bytes
+		*/
+		uint64_t GetSize() const;
+
+		/**
+		* Returns the number of committed bytes
+		*/
+		uint64_t GetCommittedBytes() const;
+
+	private:
+		void SetPagesCommitment(data::BufferMemoryRange p_range, bool p_commit);
+
+	private:
+		const bool m_sparse;
+		std::unique_ptr<Buffer> m_buffer;
+		std::vector<bool> m_committedPages;
+
+		// Fallback only, one buffer per committed page (nullptr for pages that aren't committed)
+		std::vector<std::unique_ptr<Buffer>> m_pageBuffers;
+		uint64_t m_pageSize;
+		uint64_t m_committedPageCount = 0;
+	};
+}
@@ -0,0 +1,76 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/StreamingAllocation.h>
+#include <baregl/Buffer.h>
+#include <baregl/BufferMapping.h>
+#include <baregl/Fence.h>
+
+#include <optional>
+#include <vector>
+
+namespace baregl
+{
+	/**
+	* Represents a persistently mapped ring buffer, used to stream per-frame data to the GPU without
+	* going through a driver copy.
+	* The ring is split into one region per frame in flight, each guarded by a fence.
+	*/
+	class StreamingBuffer final
+	{
+	public:
+		/**
+		* Creates a streaming buffer
+		* @param p_regionSize Size of a single region (usable bytes per frame)
+		* @param p_regionCount Number of regions (frames in flight)
+		*/
+		StreamingBuffer(uint64_t p_regionSize, uint32_t p_regionCount = 3);
+
+		/**
+		* Sub-allocates memory from the current region
+		* @param p_size Size of the allocation in bytes
+		* @param p_alignment Alignment of the returned GPU offset (e.g. UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+		* @return The allocation, or std::nullopt if the current region is full
+		*/
+		std::optional<data::StreamingAllocation> Allocate(uint64_t p_size, uint64_t p_alignment = 1);
+
+		/**
+		* Fences the current region and moves to the next one, waiting for the GPU to release it if needed.
+		* Should be called once per frame, after the commands consuming the current region have been issued.
+		*/
+		void NextFrame();
+
+		/**
+		* Returns the underlying buffer (to bind it or use the offsets of the allocations)
+		*/
+		Buffer& GetBuffer();
+
+		/**
+		* Returns the size of a single region in bytes
+		*/
+		uint64_t GetRegionSize() const;
+
+		/**
+		* Returns the number of regions
+		*/
+		uint32_t GetRegionCount() const;
+
+		/**
+		* Returns the number of bytes allocated from the current region
+		*/
+		uint64_t GetUsedBytes() const;
+
+	private:
+		Buffer m_buffer;
+		BufferMapping m_mapping;
+		std::vector<Fence> m_fences;
+		const uint64_t m_regionSize;
+		uint32_t m_currentRegion = 0;
+		uint64_t m_head = 0;
+	};
+}
@@ -0,0 +1,78 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferMemoryRange.h>
+#include <baregl/data/UploadStatistics.h>
+#include <baregl/Buffer.h>
+#include <baregl/StreamingBuffer.h>
+
+#include <map>
+#include <unordered_map>
+
+namespace baregl
+{
+	/**
+	* Gathers many small uploads into a single staging allocation, and submits them with as few
+	* GPU copies as possible.
+	* Uploads to adjacent ranges of a buffer are merged, and when uploads overlap, the latest one wins.
+	*/
+	class UploadBatcher final
+	{
+	public:
+		/**
+		* Creates an upload batcher
+		* @param p_stagingSize Maximum number of bytes that can be uploaded per frame
+		* @param p_frameCount Number of frames in flight
+		*/
+		UploadBatcher(uint64_t p_stagingSize, uint32_t p_frameCount = 3);
+
+		/**
+		* Queues an upload, the data being copied to the staging memory right away
+		* @note The destination buffer must stay alive until the batcher is flushed
+		* @param p_destination
+		* @param p_data
+		* @param p_range Destination range
+		* @return False if the staging memory of the current frame is full (nothing gets queued)
+		*/
+		bool Upload(Buffer& p_destination, const void* p_data, data::BufferMemoryRange p_range);
+
+		/**
+		* Issues the copies of all the queued uploads
+		*/
+		void Flush();
+
+		/**
+		* Flushes the queued uploads and moves to the next frame.
+		* Should be called once per frame.
+		*/
+		void NextFrame();
+
+		/**
+		* Returns the statistics of the last completed frame
+		*/
+		const data::UploadStatistics& GetStatistics() const;
+
+	private:
+		struct Piece
+		{
+			uint64_t size;
+			uint64_t stagingOffset;
+		};
+
+		// Pieces of a destination buffer to update, indexed by destination offset, never overlapping
+		using PieceMap = std::map<uint64_t, Piece>;
+
+		static void Overwrite(PieceMap& p_pieces, uint64_t p_offset, const Piece& p_piece);
+
+	private:
+		StreamingBuffer m_staging;
+		std::unordered_map<Buffer*, PieceMap> m_pending;
+		data::UploadStatistics m_currentStatistics;
+		data::UploadStatistics m_lastStatistics;
+	};
+}
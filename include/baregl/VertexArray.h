@@ -7,10 +7,17 @@
 #pragma once
 
 #include <baregl/data/VertexAttribute.h>
+#include <baregl/data/VertexBindingFormat.h>
+#include <baregl/data/VertexBufferLayout.h>
 #include <baregl/detail/NativeObject.h>
 #include <baregl/types/EDataType.h>
 #include <baregl/Buffer.h>
 
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
 namespace baregl
 {
 	/**
@@ -46,6 +53,41 @@ namespace baregl
 			Buffer& p_indexBuffer
 		);
 
+		/**
+		* Sets the vertex attribute layout from multiple vertex buffers, each with its own offset, stride and divisor.
+		* Attribute locations are assigned in order, starting with the attributes of the first buffer.
+		* @note Buffers with a non-zero divisor provide per-instance attributes (hardware instancing)
+		* @param p_vertexBuffers
+		* @param p_indexBuffer (Optional) Index buffer
+		*/
+		void SetLayout(
+			std::initializer_list<data::VertexBufferLayout> p_vertexBuffers,
+			std::optional<std::reference_wrapper<const Buffer>> p_indexBuffer = std::nullopt
+		);
+
+		/**
+		* Sets the vertex attribute layout without attaching any buffer, so that the vertex array describes a vertex format.
+		* Buffers are then attached with SetVertexBuffer and SetIndexBuffer, and can be swapped without re-specifying the layout.
+		* Attribute locations are assigned in order, starting with the attributes of the first binding.
+		* @param p_bindings
+		*/
+		void SetLayout(std::initializer_list<data::VertexBindingFormat> p_bindings);
+
+		/**
+		* Attaches a vertex buffer to the given binding.
+		* @param p_binding Index of the binding, in the order the layout declared it
+		* @param p_buffer
+		* @param p_offset Offset of the first element in the buffer, in bytes
+		* @param p_stride (Optional) Distance between two elements in bytes, tightly packed attributes if not specified
+		*/
+		void SetVertexBuffer(uint32_t p_binding, const Buffer& p_buffer, uint64_t p_offset = 0, std::optional<uint32_t> p_stride = std::nullopt);
+
+		/**
+		* Attaches an index buffer.
+		* @param p_buffer
+		*/
+		void SetIndexBuffer(const Buffer& p_buffer);
+
 		/**
 		* Resets the vertex attribute layout.
 		*/
@@ -61,7 +103,11 @@ namespace baregl
 		*/
 		void Unbind() const;
 
+	private:
+		uint32_t SetupBinding(data::VertexAttributeLayout p_attributes, uint32_t p_divisor);
+
 	private:
 		uint32_t m_attributeCount = 0;
+		std::vector<uint32_t> m_bindingStrides;
 	};
 }
@@ -0,0 +1,67 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/VertexAttribute.h>
+#include <baregl/data/VertexBindingFormat.h>
+#include <baregl/VertexArray.h>
+
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace baregl
+{
+	/**
+	* Interns vertex formats, handing back a single shared vertex array per unique format.
+	* Returned vertex arrays only hold a layout (see VertexArray::SetLayout with data::VertexBindingFormat),
+	* buffers are expected to be attached per mesh with VertexArray::SetVertexBuffer and VertexArray::SetIndexBuffer.
+	*/
+	class VertexLayoutCache final
+	{
+	public:
+		/**
+		* Returns the vertex array matching the given single binding format, creating it if needed
+		* @param p_attributes
+		*/
+		std::shared_ptr<VertexArray> Get(data::VertexAttributeLayout p_attributes);
+
+		/**
+		* Returns the vertex array matching the given format, creating it if needed
+		* @param p_bindings
+		*/
+		std::shared_ptr<VertexArray> Get(std::initializer_list<data::VertexBindingFormat> p_bindings);
+
+		/**
+		* Destroys the vertex arrays that are only referenced by the cache
+		* @return The number of vertex arrays destroyed
+		*/
+		uint32_t Purge();
+
+		/**
+		* Releases every vertex array held by the cache
+		* @note Vertex arrays still referenced outside of the cache stay alive
+		*/
+		void Clear();
+
+		/**
+		* Returns the number of unique formats in the cache
+		*/
+		uint32_t GetSize() const;
+
+	private:
+		using FormatKey = std::vector<uint32_t>;
+
+		struct FormatKeyHash
+		{
+			size_t operator()(const FormatKey& p_key) const;
+		};
+
+		std::unordered_map<FormatKey, std::shared_ptr<VertexArray>, FormatKeyHash> m_vertexArrays;
+	};
+}
@@ -0,0 +1,23 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/math/Vec3.h>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing a world space bounding sphere, laid out to be read from a shader storage buffer (vec4).
+	*/
+	struct BoundingSphere
+	{
+		math::Vec3 center;
+		float radius;
+	};
+
+	static_assert(sizeof(BoundingSphere) == 16, "BoundingSphere must match the std430 vec4 layout");
+}
@@ -0,0 +1,28 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/BufferMemoryRange.h>
+
+#include <functional>
+
+namespace baregl
+{
+	class Buffer;
+}
+
+namespace baregl::data
+{
+	/**
+	* Struct representing a range of a buffer to bind to an indexed binding point.
+	*/
+	struct BufferBinding
+	{
+		std::reference_wrapper<const Buffer> buffer;
+		BufferMemoryRange range;
+	};
+}
@@ -0,0 +1,22 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing a region to copy from a buffer to another.
+	*/
+	struct BufferCopyRegion
+	{
+		uint64_t sourceOffset;
+		uint64_t destinationOffset;
+		uint64_t size;
+	};
+}
@@ -0,0 +1,24 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing a compute dispatch, as read by the GPU from a dispatch-indirect buffer.
+	*/
+	struct DispatchIndirectCommand
+	{
+		uint32_t groupCountX;
+		uint32_t groupCountY;
+		uint32_t groupCountZ;
+	};
+
+	static_assert(sizeof(DispatchIndirectCommand) == 12, "DispatchIndirectCommand must match the GL layout");
+}
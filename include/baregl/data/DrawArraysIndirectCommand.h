@@ -0,0 +1,25 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing a non-indexed draw, as read by the GPU from a draw-indirect buffer.
+	*/
+	struct DrawArraysIndirectCommand
+	{
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t first;
+		uint32_t baseInstance;
+	};
+
+	static_assert(sizeof(DrawArraysIndirectCommand) == 16, "DrawArraysIndirectCommand must match the GL layout");
+}
@@ -0,0 +1,26 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing an indexed draw, as read by the GPU from a draw-indirect buffer.
+	*/
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+	};
+
+	static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand must match the GL layout");
+}
@@ -0,0 +1,48 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/types/EIndexType.h>
+#include <baregl/types/EPrimitiveMode.h>
+
+#include <array>
+#include <cstdint>
+
+namespace baregl
+{
+	class PipelineState;
+	class ShaderProgram;
+	class Texture;
+	class VertexArray;
+}
+
+namespace baregl::data
+{
+	/**
+	* Struct representing a draw call along with the objects it needs to be bound.
+	* Per-draw data is expected to be fetched in the shader using the base instance (e.g. from a shader storage buffer).
+	*/
+	struct DrawPacket
+	{
+		static constexpr uint32_t k_maxTextures = 4;
+
+		uint8_t pass = 0;											// Packets are submitted pass by pass (0 to 15)
+		float depth = 0.0f;											// Within a pass and a state bucket, packets are submitted front to back
+		const ShaderProgram* program = nullptr;
+		const PipelineState* pipelineState = nullptr;				// (Optional) Fixed-function state to apply, the default one if null
+		const VertexArray* vertexArray = nullptr;
+		std::array<const Texture*, k_maxTextures> textures{};		// Textures bound to the slot matching their index, null slots being unbound
+		types::EPrimitiveMode primitiveMode = types::EPrimitiveMode::TRIANGLES;
+		bool indexed = true;										// Draws elements if true, arrays otherwise
+		types::EIndexType indexType = types::EIndexType::UNSIGNED_INT;
+		uint32_t count = 0;											// Number of indices (or vertices if not indexed)
+		uint32_t instances = 1;
+		uint32_t first = 0;											// First index (or vertex if not indexed)
+		int32_t baseVertex = 0;
+		uint32_t baseInstance = 0;
+	};
+}
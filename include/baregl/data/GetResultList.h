@@ -16,7 +16,7 @@
 	X(VERTEX_BINDING_DIVISOR, int, baregl::data::FixedCount<1>, BOTH, int) \
 	X(VERTEX_BINDING_BUFFER, int, baregl::data::FixedCount<1>, BOTH, uint32_t) \
 	X(ARRAY_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
-	X(DRAW_INDIRECT_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
+	X(DRAW_INDIRECT_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
 	X(VERTEX_ARRAY_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
 	X(PRIMITIVE_RESTART, bool, baregl::data::FixedCount<1>, NOT_INDEXED, bool) \
 	X(PRIMITIVE_RESTART_FIXED_INDEX, bool, baregl::data::FixedCount<1>, NOT_INDEXED, bool) \
@@ -168,7 +168,7 @@
 	X(IMAGE_BINDING_LAYER, int, baregl::data::FixedCount<1>, BOTH, int) \
 	X(IMAGE_BINDING_ACCESS, int, baregl::data::FixedCount<1>, BOTH, types::EImageAccessSpecifier) \
 	X(IMAGE_BINDING_FORMAT, int, baregl::data::FixedCount<1>, BOTH, types::EInternalFormat) \
-	X(ATOMIC_COUNTER_BUFFER_BINDING, int, baregl::data::FixedCount<1>, BOTH, int) \
+	X(ATOMIC_COUNTER_BUFFER_BINDING, int, baregl::data::FixedCount<1>, BOTH, uint32_t) \
 	X(ATOMIC_COUNTER_BUFFER_START, int64_t, baregl::data::FixedCount<1>, INDEXED, int64_t) \
 	X(ATOMIC_COUNTER_BUFFER_SIZE, int64_t, baregl::data::FixedCount<1>, INDEXED, int64_t) \
 	X(SHADER_STORAGE_BUFFER_BINDING, int, baregl::data::FixedCount<1>, BOTH, uint32_t) \
@@ -371,11 +371,11 @@
 	X(SAMPLES, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
 	X(IMPLEMENTATION_COLOR_READ_FORMAT, int, baregl::data::FixedCount<1>, NOT_INDEXED, types::EPixelDataFormat) \
 	X(IMPLEMENTATION_COLOR_READ_TYPE, int, baregl::data::FixedCount<1>, NOT_INDEXED, types::EPixelDataType) \
-	X(QUERY_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
-	X(COPY_READ_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
-	X(COPY_WRITE_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
+	X(QUERY_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
+	X(COPY_READ_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
+	X(COPY_WRITE_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
 	X(RESET_NOTIFICATION_STRATEGY, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
-	X(TEXTURE_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, int) \
+	X(TEXTURE_BUFFER_BINDING, int, baregl::data::FixedCount<1>, NOT_INDEXED, uint32_t) \
 	X(TEXTURE_CUBE_MAP_SEAMLESS, bool, baregl::data::FixedCount<1>, NOT_INDEXED, bool) \
 	X(TIMESTAMP, int64_t, baregl::data::FixedCount<1>, NOT_INDEXED, int64_t)
 
@@ -0,0 +1,53 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/types/EBlendingEquation.h>
+#include <baregl/types/EBlendingFactor.h>
+#include <baregl/types/EComparaisonAlgorithm.h>
+#include <baregl/types/ECullFace.h>
+#include <baregl/types/EOperation.h>
+#include <baregl/types/ERasterizationMode.h>
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Structure that holds the fixed-function state of a pipeline, initialized to the OpenGL defaults
+	*/
+	struct PipelineStateDesc
+	{
+		bool blending = false;
+		types::EBlendingFactor blendingSourceFactor = types::EBlendingFactor::ONE;
+		types::EBlendingFactor blendingDestinationFactor = types::EBlendingFactor::ZERO;
+		types::EBlendingEquation blendingEquation = types::EBlendingEquation::FUNC_ADD;
+
+		bool depthTest = false;
+		bool depthWriting = true;
+		types::EComparaisonAlgorithm depthAlgorithm = types::EComparaisonAlgorithm::LESS;
+
+		bool stencilTest = false;
+		types::EComparaisonAlgorithm stencilAlgorithm = types::EComparaisonAlgorithm::ALWAYS;
+		int32_t stencilReference = 0;
+		uint32_t stencilAlgorithmMask = 0xFFFFFFFF;
+		uint32_t stencilWriteMask = 0xFFFFFFFF;
+		types::EOperation stencilFailOperation = types::EOperation::KEEP;
+		types::EOperation depthFailOperation = types::EOperation::KEEP;
+		types::EOperation bothPassOperation = types::EOperation::KEEP;
+
+		bool culling = false;
+		types::ECullFace cullFace = types::ECullFace::BACK;
+		types::ERasterizationMode rasterizationMode = types::ERasterizationMode::FILL;
+		float lineWidth = 1.0f;
+
+		bool colorWritingRed = true;
+		bool colorWritingGreen = true;
+		bool colorWritingBlue = true;
+		bool colorWritingAlpha = true;
+	};
+}
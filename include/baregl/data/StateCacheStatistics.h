@@ -0,0 +1,21 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing the number of state calls going through the context state cache.
+	*/
+	struct StateCacheStatistics
+	{
+		uint64_t submittedCalls = 0;	// Number of calls forwarded to the driver
+		uint64_t elidedCalls = 0;		// Number of calls skipped because the state was already set
+	};
+}
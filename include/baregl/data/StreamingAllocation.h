@@ -0,0 +1,23 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace baregl::data
+{
+	/**
+	* Structure representing a writable sub-allocation of a streaming buffer.
+	*/
+	struct StreamingAllocation
+	{
+		std::span<std::byte> data;
+		uint64_t offset;
+	};
+}
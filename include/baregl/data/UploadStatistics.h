@@ -0,0 +1,25 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct representing the statistics of the uploads batched during a frame.
+	*/
+	struct UploadStatistics
+	{
+		uint32_t uploadCount = 0;	// Number of uploads requested
+		uint32_t commandCount = 0;	// Number of copy commands issued
+		uint32_t savedCommands = 0;	// Number of commands saved compared to one command per upload (0 if more were issued)
+		uint64_t uploadedBytes = 0;	// Number of bytes requested
+		uint64_t copiedBytes = 0;	// Number of bytes copied
+		uint64_t savedBytes = 0;	// Number of bytes saved by not copying overwritten data
+	};
+}
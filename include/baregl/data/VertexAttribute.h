@@ -14,7 +14,11 @@
 namespace baregl::data
 {
 	/**
-	* Vertex attribute using glVertexAttribPointer (data converted to float).
+	* Vertex attribute using glVertexArrayAttribFormat (data converted to float).
+	* Packed types are supported: INT_2_10_10_10_REV and UNSIGNED_INT_2_10_10_10_REV require 4 components,
+	* UNSIGNED_INT_10F_11F_11F_REV requires 3 (see utils/VertexQuantization.h to encode them).
+	* Attributes are tightly packed, so smaller types should be padded to keep the next attributes 4-byte aligned
+	* (e.g. HALF_FLOAT with 2 or 4 components).
 	*/
 	struct FloatVertexAttribute
 	{
@@ -24,7 +28,7 @@ namespace baregl::data
 	};
 
 	/**
-	* Vertex attribute using glVertexAttribIPointer (integer data kept as-is).
+	* Vertex attribute using glVertexArrayAttribIFormat (integer data kept as-is).
 	* Valid types: BYTE, UNSIGNED_BYTE, SHORT, UNSIGNED_SHORT, INT, UNSIGNED_INT.
 	*/
 	struct IntegerVertexAttribute
@@ -34,7 +38,7 @@ namespace baregl::data
 	};
 
 	/**
-	* Vertex attribute using glVertexAttribLPointer (double-precision data kept as-is).
+	* Vertex attribute using glVertexArrayAttribLFormat (double-precision data kept as-is).
 	*/
 	struct DoubleVertexAttribute
 	{
@@ -0,0 +1,23 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/VertexAttribute.h>
+
+#include <cstdint>
+
+namespace baregl::data
+{
+	/**
+	* Struct describing the attributes fed by a vertex buffer binding, independently of any buffer.
+	*/
+	struct VertexBindingFormat
+	{
+		VertexAttributeLayout attributes;
+		uint32_t divisor = 0;	// Number of instances sharing an element (0 means the buffer advances per vertex)
+	};
+}
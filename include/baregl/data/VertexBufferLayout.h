@@ -0,0 +1,32 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/VertexAttribute.h>
+
+#include <cstdint>
+#include <functional>
+
+namespace baregl
+{
+	class Buffer;
+}
+
+namespace baregl::data
+{
+	/**
+	* Struct describing a vertex buffer binding of a vertex array, along with the attributes it feeds.
+	*/
+	struct VertexBufferLayout
+	{
+		std::reference_wrapper<const Buffer> buffer;
+		VertexAttributeLayout attributes;
+		uint64_t offset = 0;	// Offset of the first element in the buffer, in bytes
+		uint32_t stride = 0;	// Distance between two elements in bytes (0 means tightly packed attributes)
+		uint32_t divisor = 0;	// Number of instances sharing an element (0 means the buffer advances per vertex)
+	};
+}
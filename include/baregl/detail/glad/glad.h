@@ -7,16 +7,17 @@
     APIs: gl=4.5
     Profile: core
     Extensions:
-        
+        GL_ARB_indirect_parameters
+        GL_ARB_sparse_buffer
     Loader: True
     Local files: True
     Omit khrplatform: False
     Reproducible: False
 
     Commandline:
-        --profile="core" --api="gl=4.5" --generator="c" --spec="gl" --local-files --extensions=""
+        --profile="core" --api="gl=4.5" --generator="c" --spec="gl" --local-files --extensions="GL_ARB_indirect_parameters,GL_ARB_sparse_buffer"
     Online:
-        https://glad.dav1d.de/#profile=core&language=c&specification=gl&loader=on&api=gl%3D4.5
+        https://glad.dav1d.de/#profile=core&language=c&specification=gl&loader=on&api=gl%3D4.5&extensions=GL_ARB_indirect_parameters&extensions=GL_ARB_sparse_buffer
 */
 
 
@@ -3648,6 +3649,33 @@ typedef void (APIENTRYP PFNGLTEXTUREBARRIERPROC)(void);
 GLAPI PFNGLTEXTUREBARRIERPROC glad_glTextureBarrier;
 #define glTextureBarrier glad_glTextureBarrier
 #endif
+#define GL_SPARSE_STORAGE_BIT_ARB 0x0400
+#define GL_SPARSE_BUFFER_PAGE_SIZE_ARB 0x82F8
+#ifndef GL_ARB_sparse_buffer
+#define GL_ARB_sparse_buffer 1
+GLAPI int GLAD_GL_ARB_sparse_buffer;
+typedef void (APIENTRYP PFNGLBUFFERPAGECOMMITMENTARBPROC)(GLenum target, GLintptr offset, GLsizeiptr size, GLboolean commit);
+GLAPI PFNGLBUFFERPAGECOMMITMENTARBPROC glad_glBufferPageCommitmentARB;
+#define glBufferPageCommitmentARB glad_glBufferPageCommitmentARB
+typedef void (APIENTRYP PFNGLNAMEDBUFFERPAGECOMMITMENTEXTPROC)(GLuint buffer, GLintptr offset, GLsizeiptr size, GLboolean commit);
+GLAPI PFNGLNAMEDBUFFERPAGECOMMITMENTEXTPROC glad_glNamedBufferPageCommitmentEXT;
+#define glNamedBufferPageCommitmentEXT glad_glNamedBufferPageCommitmentEXT
+typedef void (APIENTRYP PFNGLNAMEDBUFFERPAGECOMMITMENTARBPROC)(GLuint buffer, GLintptr offset, GLsizeiptr size, GLboolean commit);
+GLAPI PFNGLNAMEDBUFFERPAGECOMMITMENTARBPROC glad_glNamedBufferPageCommitmentARB;
+#define glNamedBufferPageCommitmentARB glad_glNamedBufferPageCommitmentARB
+#endif
+#define GL_PARAMETER_BUFFER_ARB 0x80EE
+#define GL_PARAMETER_BUFFER_BINDING_ARB 0x80EF
+#ifndef GL_ARB_indirect_parameters
+#define GL_ARB_indirect_parameters 1
+GLAPI int GLAD_GL_ARB_indirect_parameters;
+typedef void (APIENTRYP PFNGLMULTIDRAWARRAYSINDIRECTCOUNTARBPROC)(GLenum mode, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+GLAPI PFNGLMULTIDRAWARRAYSINDIRECTCOUNTARBPROC glad_glMultiDrawArraysIndirectCountARB;
+#define glMultiDrawArraysIndirectCountARB glad_glMultiDrawArraysIndirectCountARB
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTARBPROC)(GLenum mode, GLenum type, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+GLAPI PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTARBPROC glad_glMultiDrawElementsIndirectCountARB;
+#define glMultiDrawElementsIndirectCountARB glad_glMultiDrawElementsIndirectCountARB
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,32 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/utils/BitmaskOperators.h>
+
+#include <cstdint>
+
+namespace baregl::types
+{
+	/**
+	* Enumeration of flags describing how a buffer range is mapped into client memory
+	*/
+	enum class EBufferMapFlags : uint8_t
+	{
+		NONE = 0x0,
+		READ = 0x1,
+		WRITE = 0x2,
+		PERSISTENT = 0x4,
+		COHERENT = 0x8,
+		INVALIDATE_RANGE = 0x10,
+		INVALIDATE_BUFFER = 0x20,
+		FLUSH_EXPLICIT = 0x40,
+		UNSYNCHRONIZED = 0x80
+	};
+}
+
+ENABLE_BITMASK_OPERATORS(baregl::types::EBufferMapFlags);
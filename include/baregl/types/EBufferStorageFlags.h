@@ -0,0 +1,31 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/utils/BitmaskOperators.h>
+
+#include <cstdint>
+
+namespace baregl::types
+{
+	/**
+	* Enumeration of flags describing the intended usage of an immutable buffer storage
+	*/
+	enum class EBufferStorageFlags : uint8_t
+	{
+		NONE = 0x0,
+		DYNAMIC_STORAGE = 0x1,
+		MAP_READ = 0x2,
+		MAP_WRITE = 0x4,
+		MAP_PERSISTENT = 0x8,
+		MAP_COHERENT = 0x10,
+		CLIENT_STORAGE = 0x20,
+		SPARSE_STORAGE = 0x40 // Requires GL_ARB_sparse_buffer
+	};
+}
+
+ENABLE_BITMASK_OPERATORS(baregl::types::EBufferStorageFlags);
@@ -19,6 +19,17 @@ namespace baregl::types
 		INDEX,
 		UNIFORM,
 		SHADER_STORAGE,
+		PIXEL_PACK,
+		PIXEL_UNPACK,
+		DRAW_INDIRECT,
+		DISPATCH_INDIRECT,
+		ATOMIC_COUNTER,
+		QUERY,
+		COPY_READ,
+		COPY_WRITE,
+		TEXTURE,
+		TRANSFORM_FEEDBACK,
+		PARAMETER, // Requires GL_ARB_indirect_parameters
 		UNKNOWN
 	};
 }
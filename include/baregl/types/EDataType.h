@@ -22,6 +22,10 @@ namespace baregl::types
 		INT,
 		UNSIGNED_INT,
 		FLOAT,
-		DOUBLE
+		DOUBLE,
+		HALF_FLOAT,
+		INT_2_10_10_10_REV,				// Packed, 4 components in 32 bits
+		UNSIGNED_INT_2_10_10_10_REV,	// Packed, 4 components in 32 bits
+		UNSIGNED_INT_10F_11F_11F_REV	// Packed, 3 unsigned floats in 32 bits
 	};
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace baregl::types
+{
+	/**
+	* Enumeration of index types
+	*/
+	enum class EIndexType : uint8_t
+	{
+		UNSIGNED_BYTE,
+		UNSIGNED_SHORT,
+		UNSIGNED_INT
+	};
+}
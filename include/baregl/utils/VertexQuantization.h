@@ -0,0 +1,47 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/math/Vec3.h>
+#include <baregl/math/Vec4.h>
+
+#include <cstdint>
+#include <span>
+
+namespace baregl::utils
+{
+	/**
+	* Converts floats to half floats (EDataType::HALF_FLOAT), rounding to nearest even
+	* @param p_source
+	* @param p_destination Must hold at least as many elements as the source
+	*/
+	void QuantizeToHalfFloat(std::span<const float> p_source, std::span<uint16_t> p_destination);
+
+	/**
+	* Packs vectors with components in [-1, 1] into signed normalized words (EDataType::INT_2_10_10_10_REV, normalized)
+	* @note Components are clamped, the w component only keeps its sign (-1, 0 or 1)
+	* @param p_source
+	* @param p_destination Must hold at least as many elements as the source
+	*/
+	void QuantizeToInt2_10_10_10Rev(std::span<const math::Vec4> p_source, std::span<uint32_t> p_destination);
+
+	/**
+	* Packs vectors with components in [0, 1] into unsigned normalized words (EDataType::UNSIGNED_INT_2_10_10_10_REV, normalized)
+	* @note Components are clamped, the w component is quantized to 2 bits
+	* @param p_source
+	* @param p_destination Must hold at least as many elements as the source
+	*/
+	void QuantizeToUnsignedInt2_10_10_10Rev(std::span<const math::Vec4> p_source, std::span<uint32_t> p_destination);
+
+	/**
+	* Packs vectors into unsigned 11, 11 and 10 bits floats (EDataType::UNSIGNED_INT_10F_11F_11F_REV)
+	* @note Negative components are clamped to 0
+	* @param p_source
+	* @param p_destination Must hold at least as many elements as the source
+	*/
+	void QuantizeToUnsignedInt10F_11F_11F_Rev(std::span<const math::Vec3> p_source, std::span<uint32_t> p_destination);
+}
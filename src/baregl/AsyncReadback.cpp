@@ -0,0 +1,178 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/AsyncReadback.h>
+
+#include <baregl/debug/Assert.h>
+#include <baregl/detail/glad/glad.h>
+#include <baregl/detail/PixelTransfer.h>
+#include <baregl/detail/Types.h>
+
+namespace
+{
+	uint32_t GetComponentCount(baregl::types::EPixelDataFormat p_format)
+	{
+		using enum baregl::types::EPixelDataFormat;
+
+		switch (p_format)
+		{
+		case LUMINANCE_ALPHA: return 2;
+		case RGB: case BGR: return 3;
+		case RGBA: case BGRA: return 4;
+		default: return 1;
+		}
+	}
+
+	uint32_t GetPixelSizeInBytes(baregl::types::EPixelDataFormat p_format, baregl::types::EPixelDataType p_type)
+	{
+		using enum baregl::types::EPixelDataType;
+
+		switch (p_type)
+		{
+		case BYTE: case UNSIGNED_BYTE: return GetComponentCount(p_format);
+		case SHORT: case UNSIGNED_SHORT: return 2 * GetComponentCount(p_format);
+		case INT: case UNSIGNED_INT: case FLOAT: return 4 * GetComponentCount(p_format);
+
+		// Packed types store the whole pixel in a single value
+		case UNSIGNED_BYTE_3_3_2: case UNSIGNED_BYTE_2_3_3_REV: return 1;
+		case UNSIGNED_SHORT_5_6_5: case UNSIGNED_SHORT_5_6_5_REV:
+		case UNSIGNED_SHORT_4_4_4_4: case UNSIGNED_SHORT_4_4_4_4_REV:
+		case UNSIGNED_SHORT_5_5_5_1: case UNSIGNED_SHORT_1_5_5_5_REV: return 2;
+		case UNSIGNED_INT_8_8_8_8: case UNSIGNED_INT_8_8_8_8_REV:
+		case UNSIGNED_INT_10_10_10_2: case UNSIGNED_INT_2_10_10_10_REV: return 4;
+		default: break;
+		}
+
+		BAREGL_ASSERT(false, "Unsupported pixel data type for readback");
+		return 0;
+	}
+
+	uint64_t GetReadbackSize(
+		uint32_t p_width,
+		uint32_t p_height,
+		baregl::types::EPixelDataFormat p_format,
+		baregl::types::EPixelDataType p_type
+	)
+	{
+		GLint packAlignment = 4;
+		glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+
+		const uint64_t alignment = static_cast<uint64_t>(packAlignment);
+		const uint64_t rowSize = static_cast<uint64_t>(p_width) * GetPixelSizeInBytes(p_format, p_type);
+		const uint64_t rowStride = (rowSize + alignment - 1) / alignment * alignment;
+
+		// The last row isn't padded
+		return rowStride * (p_height - 1) + rowSize;
+	}
+}
+
+namespace baregl
+{
+	AsyncReadback::AsyncReadback(uint64_t p_slotSize, uint32_t p_slotCount) :
+		m_slots(p_slotCount),
+		m_slotSize{ p_slotSize }
+	{
+		BAREGL_ASSERT(p_slotSize > 0, "Readback slots cannot be empty");
+		BAREGL_ASSERT(p_slotCount > 0, "Async readback requires at least one slot");
+
+		for (auto& slot : m_slots)
+		{
+			slot.buffer.Allocate(
+				p_slotSize,
+				types::EBufferStorageFlags::MAP_READ |
+				types::EBufferStorageFlags::CLIENT_STORAGE
+			);
+		}
+	}
+
+	bool AsyncReadback::Request(
+		uint32_t p_x,
+		uint32_t p_y,
+		uint32_t p_width,
+		uint32_t p_height,
+		types::EPixelDataFormat p_format,
+		types::EPixelDataType p_type,
+		std::optional<std::reference_wrapper<const Framebuffer>> p_framebuffer
+	)
+	{
+		BAREGL_ASSERT(p_width > 0 && p_height > 0, "Invalid read size");
+
+		if (m_pendingCount == GetSlotCount())
+		{
+			return false;
+		}
+
+		auto& slot = m_slots[(m_head + m_pendingCount) % GetSlotCount()];
+
+		BAREGL_ASSERT(!slot.buffer.IsMapped(), "Readback slot is still mapped, release previous results before requesting new ones");
+
+		slot.size = GetReadbackSize(p_width, p_height, p_format, p_type);
+
+		BAREGL_ASSERT(slot.size <= m_slotSize, "Readback doesn't fit in a slot");
+
+		// With a pixel-pack buffer bound, the data pointer is interpreted as an offset into the buffer
+		slot.buffer.Bind(types::EBufferType::PIXEL_PACK);
+
+		if (p_framebuffer.has_value())
+		{
+			p_framebuffer->get().ReadPixels(p_x, p_y, p_width, p_height, p_format, p_type, nullptr);
+		}
+		else
+		{
+			detail::ReadPixels(p_x, p_y, p_width, p_height, p_format, p_type, nullptr);
+		}
+
+		slot.buffer.Unbind();
+		slot.fence.Insert();
+
+		++m_pendingCount;
+
+		return true;
+	}
+
+	std::optional<BufferMapping> AsyncReadback::Poll()
+	{
+		if (m_pendingCount == 0 || !m_slots[m_head].fence.IsSignaled())
+		{
+			return std::nullopt;
+		}
+
+		return Retrieve();
+	}
+
+	std::optional<BufferMapping> AsyncReadback::Wait()
+	{
+		if (m_pendingCount == 0)
+		{
+			return std::nullopt;
+		}
+
+		m_slots[m_head].fence.Wait();
+
+		return Retrieve();
+	}
+
+	uint32_t AsyncReadback::GetPendingCount() const
+	{
+		return m_pendingCount;
+	}
+
+	uint32_t AsyncReadback::GetSlotCount() const
+	{
+		return static_cast<uint32_t>(m_slots.size());
+	}
+
+	BufferMapping AsyncReadback::Retrieve()
+	{
+		auto& slot = m_slots[m_head];
+
+		slot.fence.Reset();
+		m_head = (m_head + 1) % GetSlotCount();
+		--m_pendingCount;
+
+		return slot.buffer.MapRange({ .offset = 0, .size = slot.size }, types::EBufferMapFlags::READ);
+	}
+}
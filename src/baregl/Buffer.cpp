@@ -8,6 +8,7 @@
 
 #include <baregl/debug/Assert.h>
 #include <baregl/debug/Event.h>
+#include <baregl/detail/BufferTargets.h>
 #include <baregl/detail/glad/glad.h>
 #include <baregl/detail/Types.h>
 
@@ -21,6 +22,12 @@ namespace baregl
 
 	Buffer::~Buffer()
 	{
+		// Deleting a mapped buffer unmaps it, the mapping must not try to unmap it again (its name could be reused)
+		if (m_mapping)
+		{
+			m_mapping->Release();
+		}
+
 		glDeleteBuffers(1, &m_id);
 		NOTIFY_BUFFER_DESTROYED;
 	}
@@ -28,14 +35,59 @@ namespace baregl
 	uint64_t Buffer::Allocate(uint64_t p_size, types::EAccessSpecifier p_usage)
 	{
 		BAREGL_ASSERT(IsValid(), "Cannot allocate memory for an invalid buffer");
+		BAREGL_ASSERT(!IsImmutable(), "Cannot reallocate an immutable buffer");
 		glNamedBufferData(m_id, p_size, nullptr, utils::EnumToValue<GLenum>(p_usage));
+		m_usage = p_usage;
+		return m_allocatedBytes = p_size;
+	}
+
+	uint64_t Buffer::Allocate(uint64_t p_size, types::EBufferStorageFlags p_flags, const void* p_data)
+	{
+		using enum types::EBufferStorageFlags;
+
+		BAREGL_ASSERT(IsValid(), "Cannot allocate memory for an invalid buffer");
+		BAREGL_ASSERT(!IsImmutable(), "Cannot reallocate an immutable buffer");
+		BAREGL_ASSERT(p_size > 0, "Cannot allocate an empty immutable buffer");
+		BAREGL_ASSERT(
+			!IsFlagSet(p_flags, MAP_PERSISTENT) || IsFlagSet(p_flags, MAP_READ | MAP_WRITE),
+			"Persistent mapping requires MAP_READ or MAP_WRITE"
+		);
+		BAREGL_ASSERT(
+			!IsFlagSet(p_flags, MAP_COHERENT) || IsFlagSet(p_flags, MAP_PERSISTENT),
+			"Coherent mapping requires MAP_PERSISTENT"
+		);
+
+		glNamedBufferStorage(m_id, p_size, p_data, utils::EnumToValue<GLbitfield>(p_flags));
+		m_storageFlags = p_flags;
 		return m_allocatedBytes = p_size;
 	}
 
-	void Buffer::Upload(const void* p_data, std::optional<data::BufferMemoryRange> p_range)
+	void Buffer::Upload(
+		const void* p_data,
+		std::optional<data::BufferMemoryRange> p_range,
+		bool p_orphan
+	)
 	{
 		BAREGL_ASSERT(IsValid(), "Trying to upload data to an invalid buffer");
 		BAREGL_ASSERT(!IsEmpty(), "Trying to upload data to an empty buffer");
+		BAREGL_ASSERT(
+			!IsImmutable() || IsFlagSet(m_storageFlags.value(), types::EBufferStorageFlags::DYNAMIC_STORAGE),
+			"Trying to upload data to an immutable buffer without dynamic storage"
+		);
+
+		if (p_orphan)
+		{
+			if (IsImmutable())
+			{
+				// Immutable storage cannot be respecified, invalidating it is the closest equivalent
+				Invalidate();
+			}
+			else
+			{
+				// Respecifying the storage lets the driver hand out fresh memory while the GPU keeps reading the old one
+				glNamedBufferData(m_id, m_allocatedBytes, nullptr, utils::EnumToValue<GLenum>(m_usage));
+			}
+		}
 
 		glNamedBufferSubData(
 			m_id,
@@ -45,12 +97,127 @@ namespace baregl
 		);
 	}
 
+	void Buffer::Download(void* p_data, std::optional<data::BufferMemoryRange> p_range) const
+	{
+		const uint64_t offset = p_range ? p_range->offset : 0;
+		const uint64_t size = p_range ? p_range->size : m_allocatedBytes;
+
+		BAREGL_ASSERT(IsValid(), "Trying to download data from an invalid buffer");
+		BAREGL_ASSERT(offset + size <= m_allocatedBytes, "Downloaded range exceeds the buffer size");
+
+		glGetNamedBufferSubData(m_id, offset, size, p_data);
+	}
+
+	void Buffer::CopyFrom(
+		const Buffer& p_source,
+		uint64_t p_sourceOffset,
+		uint64_t p_destinationOffset,
+		uint64_t p_size
+	)
+	{
+		BAREGL_ASSERT(IsValid() && p_source.IsValid(), "Cannot copy from or to an invalid buffer");
+		BAREGL_ASSERT(p_sourceOffset + p_size <= p_source.GetSize(), "Copied range exceeds the source buffer size");
+		BAREGL_ASSERT(p_destinationOffset + p_size <= m_allocatedBytes, "Copied range exceeds the destination buffer size");
+		BAREGL_ASSERT(
+			&p_source != this ||
+			p_sourceOffset + p_size <= p_destinationOffset ||
+			p_destinationOffset + p_size <= p_sourceOffset,
+			"Cannot copy overlapping ranges within the same buffer"
+		);
+
+		glCopyNamedBufferSubData(p_source.GetID(), m_id, p_sourceOffset, p_destinationOffset, p_size);
+	}
+
+	void Buffer::Clear(std::optional<data::BufferMemoryRange> p_range, uint32_t p_value)
+	{
+		const uint64_t offset = p_range ? p_range->offset : 0;
+		const uint64_t size = p_range ? p_range->size : m_allocatedBytes;
+
+		BAREGL_ASSERT(IsValid(), "Cannot clear an invalid buffer");
+		BAREGL_ASSERT(offset + size <= m_allocatedBytes, "Cleared range exceeds the buffer size");
+		BAREGL_ASSERT(offset % sizeof(uint32_t) == 0 && size % sizeof(uint32_t) == 0, "Cleared range must be 4-byte aligned");
+
+		glClearNamedBufferSubData(m_id, GL_R32UI, offset, size, GL_RED_INTEGER, GL_UNSIGNED_INT, &p_value);
+	}
+
+	void Buffer::Invalidate()
+	{
+		BAREGL_ASSERT(IsValid(), "Cannot invalidate an invalid buffer");
+		glInvalidateBufferData(m_id);
+	}
+
+	void Buffer::InvalidateRange(data::BufferMemoryRange p_range)
+	{
+		BAREGL_ASSERT(IsValid(), "Cannot invalidate an invalid buffer");
+		BAREGL_ASSERT(p_range.offset + p_range.size <= m_allocatedBytes, "Invalidated range exceeds the buffer size");
+		glInvalidateBufferSubData(m_id, p_range.offset, p_range.size);
+	}
+
+	BufferMapping Buffer::Map(types::EBufferMapFlags p_flags)
+	{
+		return MapRange({ .offset = 0, .size = m_allocatedBytes }, p_flags);
+	}
+
+	BufferMapping Buffer::MapRange(data::BufferMemoryRange p_range, types::EBufferMapFlags p_flags)
+	{
+		using enum types::EBufferMapFlags;
+
+		BAREGL_ASSERT(IsValid(), "Cannot map an invalid buffer");
+		BAREGL_ASSERT(!IsMapped(), "Cannot map a buffer that is already mapped");
+		BAREGL_ASSERT(p_range.size > 0, "Cannot map an empty range");
+		BAREGL_ASSERT(p_range.offset + p_range.size <= m_allocatedBytes, "Mapped range exceeds the buffer size");
+		BAREGL_ASSERT(IsFlagSet(p_flags, READ | WRITE), "Mapping requires READ or WRITE access");
+		BAREGL_ASSERT(
+			!IsFlagSet(p_flags, INVALIDATE_RANGE | INVALIDATE_BUFFER | UNSYNCHRONIZED) || !IsFlagSet(p_flags, READ),
+			"INVALIDATE_RANGE, INVALIDATE_BUFFER and UNSYNCHRONIZED cannot be combined with READ"
+		);
+		BAREGL_ASSERT(
+			!IsFlagSet(p_flags, FLUSH_EXPLICIT) || IsFlagSet(p_flags, WRITE),
+			"FLUSH_EXPLICIT requires WRITE access"
+		);
+		BAREGL_ASSERT(
+			!IsFlagSet(p_flags, PERSISTENT | COHERENT) ||
+			(IsImmutable() && IsFlagSet(m_storageFlags.value(), types::EBufferStorageFlags::MAP_PERSISTENT)),
+			"Persistent mapping requires immutable storage allocated with MAP_PERSISTENT"
+		);
+
+		void* data = glMapNamedBufferRange(
+			m_id,
+			p_range.offset,
+			p_range.size,
+			utils::EnumToValue<GLbitfield>(p_flags)
+		);
+
+		BAREGL_ASSERT(data != nullptr, "Failed to map buffer range");
+
+		return BufferMapping{
+			*this,
+			{ static_cast<std::byte*>(data), static_cast<size_t>(p_range.size) },
+			p_range.offset,
+			p_flags
+		};
+	}
+
+	bool Buffer::IsMapped() const
+	{
+		BAREGL_ASSERT(IsValid(), "Cannot query the mapping state of an invalid buffer");
+
+		GLint mapped = GL_FALSE;
+		glGetNamedBufferParameteriv(m_id, GL_BUFFER_MAPPED, &mapped);
+		return mapped == GL_TRUE;
+	}
+
 	void Buffer::Bind(
 		types::EBufferType p_type,
 		std::optional<uint32_t> p_index
 	)
 	{
 		BAREGL_ASSERT(IsValid(), "Cannot bind an invalid buffer");
+		BAREGL_ASSERT(p_type != types::EBufferType::UNKNOWN, "Cannot bind a buffer to an unknown target");
+		BAREGL_ASSERT(
+			!p_index.has_value() || detail::IsIndexedBufferType(p_type),
+			"Only UNIFORM, SHADER_STORAGE, ATOMIC_COUNTER and TRANSFORM_FEEDBACK buffers can be bound to an index"
+		);
 
 		if (p_index.has_value())
 		{
@@ -65,6 +232,26 @@ namespace baregl
 		m_bindIndex = p_index;
 	}
 
+	void Buffer::Bind(
+		types::EBufferType p_type,
+		uint32_t p_index,
+		data::BufferMemoryRange p_range
+	)
+	{
+		BAREGL_ASSERT(IsValid(), "Cannot bind an invalid buffer");
+		BAREGL_ASSERT(
+			detail::IsIndexedBufferType(p_type),
+			"Only UNIFORM, SHADER_STORAGE, ATOMIC_COUNTER and TRANSFORM_FEEDBACK buffers can be bound to an index"
+		);
+		BAREGL_ASSERT(p_range.size > 0, "Cannot bind an empty range");
+		BAREGL_ASSERT(p_range.offset + p_range.size <= m_allocatedBytes, "Bound range exceeds the buffer size");
+
+		glBindBufferRange(utils::EnumToValue<GLenum>(p_type), p_index, m_id, p_range.offset, p_range.size);
+
+		m_boundAs = p_type;
+		m_bindIndex = p_index;
+	}
+
 	void Buffer::Unbind()
 	{
 		BAREGL_ASSERT(IsValid(), "Cannot unbind an invalid buffer");
@@ -72,7 +259,7 @@ namespace baregl
 
 		if (m_bindIndex.has_value())
 		{
-			glBindBufferBase(utils::EnumToValue<GLenum>(m_boundAs.value()), m_bindIndex.value(), m_id);
+			glBindBufferBase(utils::EnumToValue<GLenum>(m_boundAs.value()), m_bindIndex.value(), 0);
 		}
 		else
 		{
@@ -97,4 +284,14 @@ namespace baregl
 		BAREGL_ASSERT(IsValid(), "Cannot get size of an invalid buffer");
 		return m_allocatedBytes;
 	}
+
+	bool Buffer::IsImmutable() const
+	{
+		return m_storageFlags.has_value();
+	}
+
+	std::optional<types::EBufferStorageFlags> Buffer::GetStorageFlags() const
+	{
+		return m_storageFlags;
+	}
 }
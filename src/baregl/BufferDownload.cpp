@@ -0,0 +1,65 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/BufferDownload.h>
+
+#include <baregl/debug/Assert.h>
+
+namespace baregl
+{
+	BufferDownload::BufferDownload(uint64_t p_capacity)
+	{
+		BAREGL_ASSERT(p_capacity > 0, "Download staging buffer cannot be empty");
+
+		m_staging.Allocate(
+			p_capacity,
+			types::EBufferStorageFlags::MAP_READ |
+			types::EBufferStorageFlags::CLIENT_STORAGE
+		);
+	}
+
+	void BufferDownload::Request(const Buffer& p_source, std::optional<data::BufferMemoryRange> p_range)
+	{
+		const uint64_t offset = p_range ? p_range->offset : 0;
+		const uint64_t size = p_range ? p_range->size : p_source.GetSize();
+
+		BAREGL_ASSERT(size > 0, "Cannot download an empty range");
+		BAREGL_ASSERT(size <= GetCapacity(), "Download doesn't fit in the staging buffer");
+		BAREGL_ASSERT(!m_staging.IsMapped(), "Download is still mapped, release previous results before requesting new ones");
+
+		m_staging.CopyFrom(p_source, offset, 0, size);
+		m_fence.Insert();
+		m_size = size;
+	}
+
+	bool BufferDownload::IsReady() const
+	{
+		return m_fence.IsSignaled();
+	}
+
+	bool BufferDownload::Wait(uint64_t p_timeout) const
+	{
+		return m_fence.Wait(p_timeout);
+	}
+
+	BufferMapping BufferDownload::GetData()
+	{
+		BAREGL_ASSERT(m_size > 0, "No download was requested");
+
+		Wait();
+		return m_staging.MapRange({ .offset = 0, .size = m_size }, types::EBufferMapFlags::READ);
+	}
+
+	uint64_t BufferDownload::GetSize() const
+	{
+		return m_size;
+	}
+
+	uint64_t BufferDownload::GetCapacity() const
+	{
+		return m_staging.GetSize();
+	}
+}
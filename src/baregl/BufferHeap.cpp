@@ -0,0 +1,239 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/BufferHeap.h>
+
+#include <baregl/debug/Assert.h>
+
+namespace
+{
+	constexpr uint64_t AlignUp(uint64_t p_value, uint64_t p_alignment)
+	{
+		return (p_value + p_alignment - 1) / p_alignment * p_alignment;
+	}
+}
+
+namespace baregl
+{
+	BufferHeap::BufferHeap(uint64_t p_size, types::EBufferStorageFlags p_flags)
+	{
+		BAREGL_ASSERT(p_size > 0, "Buffer heap cannot be empty");
+		m_buffer.Allocate(p_size, p_flags);
+		AddFreeBlock(0, p_size);
+	}
+
+	std::optional<data::BufferMemoryRange> BufferHeap::Allocate(
+		uint64_t p_size,
+		uint64_t p_alignment,
+		RelocationCallback p_onRelocated
+	)
+	{
+		BAREGL_ASSERT(p_size > 0, "Cannot allocate an empty range");
+		BAREGL_ASSERT(p_alignment > 0, "Alignment cannot be zero");
+
+		// Best fit: smallest free block that can hold the allocation once aligned
+		for (auto it = m_freeBlocksBySize.lower_bound(p_size); it != m_freeBlocksBySize.end(); ++it)
+		{
+			const auto [blockSize, blockOffset] = *it;
+			const uint64_t offset = AlignUp(blockOffset, p_alignment);
+
+			if (offset - blockOffset + p_size > blockSize)
+			{
+				continue;
+			}
+
+			Claim(blockOffset, blockSize, offset, p_size);
+
+			m_allocations.emplace(offset, Allocation{
+				.size = p_size,
+				.alignment = p_alignment,
+				.onRelocated = std::move(p_onRelocated)
+			});
+
+			return data::BufferMemoryRange{ .offset = offset, .size = p_size };
+		}
+
+		return std::nullopt;
+	}
+
+	void BufferHeap::Free(const data::BufferMemoryRange& p_range)
+	{
+		const auto allocation = m_allocations.find(p_range.offset);
+
+		BAREGL_ASSERT(allocation != m_allocations.end(), "Trying to free a range that wasn't allocated from this heap");
+		BAREGL_ASSERT(allocation->second.size == p_range.size, "Trying to free a range with a different size than the allocation");
+
+		m_allocations.erase(allocation);
+		Release(p_range.offset, p_range.size);
+	}
+
+	uint64_t BufferHeap::Compact(uint64_t p_byteBudget)
+	{
+		uint64_t movedBytes = 0;
+		uint64_t end = 0;
+
+		for (auto it = m_allocations.begin(); it != m_allocations.end();)
+		{
+			const uint64_t from = it->first;
+			const uint64_t size = it->second.size;
+			const uint64_t to = AlignUp(end, it->second.alignment);
+
+			// Already packed against the previous allocation
+			if (to >= from)
+			{
+				end = from + size;
+				++it;
+				continue;
+			}
+
+			if (movedBytes > 0 && movedBytes + size > p_byteBudget)
+			{
+				break;
+			}
+
+			Move(from, to, size);
+
+			// The gap before the allocation merges with its previous range, from which the new range is claimed
+			Release(from, size);
+			const auto block = std::prev(m_freeBlocksByOffset.upper_bound(to));
+			Claim(block->first, block->second, to, size);
+
+			auto node = m_allocations.extract(it++);
+			node.key() = to;
+			const auto& allocation = m_allocations.insert(std::move(node)).position->second;
+
+			if (allocation.onRelocated)
+			{
+				allocation.onRelocated({ .offset = from, .size = size }, { .offset = to, .size = size });
+			}
+
+			movedBytes += size;
+			end = to + size;
+		}
+
+		return movedBytes;
+	}
+
+	Buffer& BufferHeap::GetBuffer()
+	{
+		return m_buffer;
+	}
+
+	uint64_t BufferHeap::GetSize() const
+	{
+		return m_buffer.GetSize();
+	}
+
+	uint64_t BufferHeap::GetUsedBytes() const
+	{
+		return m_usedBytes;
+	}
+
+	uint64_t BufferHeap::GetFreeBytes() const
+	{
+		return GetSize() - m_usedBytes;
+	}
+
+	uint64_t BufferHeap::GetLargestFreeBlock() const
+	{
+		return m_freeBlocksBySize.empty() ? 0 : m_freeBlocksBySize.rbegin()->first;
+	}
+
+	uint64_t BufferHeap::GetAllocationCount() const
+	{
+		return m_allocations.size();
+	}
+
+	void BufferHeap::Claim(uint64_t p_blockOffset, uint64_t p_blockSize, uint64_t p_offset, uint64_t p_size)
+	{
+		RemoveFreeBlock(p_blockOffset, p_blockSize);
+
+		if (p_offset > p_blockOffset)
+		{
+			AddFreeBlock(p_blockOffset, p_offset - p_blockOffset);
+		}
+
+		if (const uint64_t end = p_offset + p_size; end < p_blockOffset + p_blockSize)
+		{
+			AddFreeBlock(end, p_blockOffset + p_blockSize - end);
+		}
+
+		m_usedBytes += p_size;
+	}
+
+	void BufferHeap::Release(uint64_t p_offset, uint64_t p_size)
+	{
+		m_usedBytes -= p_size;
+
+		uint64_t offset = p_offset;
+		uint64_t size = p_size;
+
+		// Merge with the following free block
+		if (const auto next = m_freeBlocksByOffset.find(offset + size); next != m_freeBlocksByOffset.end())
+		{
+			size += next->second;
+			RemoveFreeBlock(next->first, next->second);
+		}
+
+		// Merge with the preceding free block
+		if (const auto next = m_freeBlocksByOffset.lower_bound(offset); next != m_freeBlocksByOffset.begin())
+		{
+			const auto previous = std::prev(next);
+
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				size += previous->second;
+				RemoveFreeBlock(previous->first, previous->second);
+			}
+		}
+
+		AddFreeBlock(offset, size);
+	}
+
+	void BufferHeap::Move(uint64_t p_from, uint64_t p_to, uint64_t p_size)
+	{
+		if (p_from - p_to >= p_size)
+		{
+			m_buffer.CopyFrom(m_buffer, p_from, p_to, p_size);
+			return;
+		}
+
+		// Copies within a buffer cannot overlap, so overlapping moves are staged through a scratch buffer.
+		// Two copies of the whole range are cheaper than one copy per chunk of the (possibly tiny) distance travelled.
+		if (m_scratchBuffer.GetSize() < p_size)
+		{
+			m_scratchBuffer.Allocate(p_size, types::EAccessSpecifier::STREAM_COPY);
+		}
+
+		m_scratchBuffer.CopyFrom(m_buffer, p_from, 0, p_size);
+		m_buffer.CopyFrom(m_scratchBuffer, 0, p_to, p_size);
+	}
+
+	void BufferHeap::AddFreeBlock(uint64_t p_offset, uint64_t p_size)
+	{
+		m_freeBlocksByOffset.emplace(p_offset, p_size);
+		m_freeBlocksBySize.emplace(p_size, p_offset);
+	}
+
+	void BufferHeap::RemoveFreeBlock(uint64_t p_offset, uint64_t p_size)
+	{
+		m_freeBlocksByOffset.erase(p_offset);
+
+		auto [first, last] = m_freeBlocksBySize.equal_range(p_size);
+
+		for (auto it = first; it != last; ++it)
+		{
+			if (it->second == p_offset)
+			{
+				m_freeBlocksBySize.erase(it);
+				return;
+			}
+		}
+
+		BAREGL_ASSERT(false, "Free block not found");
+	}
+}
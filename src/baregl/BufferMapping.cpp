@@ -0,0 +1,122 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/BufferMapping.h>
+
+#include <baregl/debug/Assert.h>
+#include <baregl/detail/glad/glad.h>
+#include <baregl/Buffer.h>
+
+#include <utility>
+
+namespace baregl
+{
+	BufferMapping::BufferMapping(
+		Buffer& p_buffer,
+		std::span<std::byte> p_data,
+		uint64_t p_offset,
+		types::EBufferMapFlags p_flags
+	) :
+		m_buffer{ &p_buffer },
+		m_data{ p_data },
+		m_offset{ p_offset },
+		m_flags{ p_flags }
+	{
+		m_buffer->m_mapping = this;
+	}
+
+	BufferMapping::~BufferMapping()
+	{
+		if (IsMapped())
+		{
+			Unmap();
+		}
+	}
+
+	BufferMapping::BufferMapping(BufferMapping&& p_other) noexcept :
+		m_buffer{ std::exchange(p_other.m_buffer, nullptr) },
+		m_data{ std::exchange(p_other.m_data, {}) },
+		m_offset{ p_other.m_offset },
+		m_flags{ p_other.m_flags }
+	{
+		if (m_buffer)
+		{
+			m_buffer->m_mapping = this;
+		}
+	}
+
+	BufferMapping& BufferMapping::operator=(BufferMapping&& p_other) noexcept
+	{
+		if (this != &p_other)
+		{
+			if (IsMapped())
+			{
+				Unmap();
+			}
+
+			m_buffer = std::exchange(p_other.m_buffer, nullptr);
+			m_data = std::exchange(p_other.m_data, {});
+			m_offset = p_other.m_offset;
+			m_flags = p_other.m_flags;
+
+			if (m_buffer)
+			{
+				m_buffer->m_mapping = this;
+			}
+		}
+
+		return *this;
+	}
+
+	void BufferMapping::FlushRange(data::BufferMemoryRange p_range)
+	{
+		BAREGL_ASSERT(IsMapped(), "Cannot flush a buffer range that isn't mapped");
+		BAREGL_ASSERT(IsFlagSet(m_flags, types::EBufferMapFlags::FLUSH_EXPLICIT), "Explicit flushes require the FLUSH_EXPLICIT flag");
+		BAREGL_ASSERT(p_range.offset + p_range.size <= m_data.size_bytes(), "Flushed range exceeds the mapped range");
+
+		glFlushMappedNamedBufferRange(m_buffer->GetID(), p_range.offset, p_range.size);
+	}
+
+	void BufferMapping::Flush()
+	{
+		FlushRange({ .offset = 0, .size = m_data.size_bytes() });
+	}
+
+	void BufferMapping::Unmap()
+	{
+		BAREGL_ASSERT(IsMapped(), "Cannot unmap a buffer range that isn't mapped");
+
+		if (glUnmapNamedBuffer(m_buffer->GetID()) == GL_FALSE)
+		{
+			// Can happen when the video memory got trashed (e.g. display mode change), the content is undefined
+			BAREGL_ASSERT(false, "Buffer content got corrupted while mapped");
+		}
+
+		Release();
+	}
+
+	bool BufferMapping::IsMapped() const
+	{
+		return m_buffer != nullptr;
+	}
+
+	data::BufferMemoryRange BufferMapping::GetRange() const
+	{
+		return { .offset = m_offset, .size = m_data.size_bytes() };
+	}
+
+	types::EBufferMapFlags BufferMapping::GetFlags() const
+	{
+		return m_flags;
+	}
+
+	void BufferMapping::Release()
+	{
+		m_buffer->m_mapping = nullptr;
+		m_buffer = nullptr;
+		m_data = {};
+	}
+}
@@ -0,0 +1,479 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/CommandList.h>
+
+#include <baregl/debug/Assert.h>
+#include <baregl/Buffer.h>
+#include <baregl/Context.h>
+#include <baregl/Texture.h>
+#include <baregl/VertexArray.h>
+
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+	enum class ECommand : uint8_t
+	{
+		BIND_PROGRAM,
+		BIND_VERTEX_ARRAY,
+		BIND_TEXTURE,
+		BIND_BUFFER,
+		BIND_BUFFER_RANGE,
+		SET_UNIFORM_INT,
+		SET_UNIFORM_UNSIGNED_INT,
+		SET_UNIFORM_FLOAT,
+		SET_UNIFORM_VEC2,
+		SET_UNIFORM_VEC3,
+		SET_UNIFORM_VEC4,
+		SET_UNIFORM_MAT3,
+		SET_UNIFORM_MAT4,
+		SET_CAPABILITY,
+		SET_DEPTH_ALGORITHM,
+		SET_DEPTH_WRITING,
+		SET_COLOR_WRITING,
+		SET_BLENDING_FUNCTION,
+		SET_CULL_FACE,
+		SET_VIEWPORT,
+		SET_CLEAR_COLOR,
+		CLEAR,
+		DRAW_ELEMENTS,
+		DRAW_ARRAYS,
+		MULTI_DRAW_ELEMENTS_INDIRECT,
+		DISPATCH_COMPUTE,
+		MEMORY_BARRIER
+	};
+
+	// Every command starts with this header, followed by its payload.
+	// Commands are padded so that each header starts on an 8 bytes boundary.
+	struct CommandHeader
+	{
+		ECommand type;
+		uint32_t size;
+	};
+
+	constexpr uint64_t k_commandAlignment = 8;
+
+	struct BindProgramCommand { const baregl::ShaderProgram* program; };
+	struct BindVertexArrayCommand { const baregl::VertexArray* vertexArray; };
+	struct BindTextureCommand { const baregl::Texture* texture; uint32_t slot; };
+	struct BindBufferCommand { baregl::Buffer* buffer; baregl::types::EBufferType type; bool indexed; uint32_t index; };
+	struct BindBufferRangeCommand { baregl::Buffer* buffer; baregl::types::EBufferType type; uint32_t index; baregl::data::BufferMemoryRange range; };
+	struct SetCapabilityCommand { baregl::types::ERenderingCapability capability; bool value; };
+	struct SetDepthAlgorithmCommand { baregl::types::EComparaisonAlgorithm algorithm; };
+	struct SetDepthWritingCommand { bool enable; };
+	struct SetColorWritingCommand { bool red; bool green; bool blue; bool alpha; };
+	struct SetBlendingFunctionCommand { baregl::types::EBlendingFactor source; baregl::types::EBlendingFactor destination; };
+	struct SetCullFaceCommand { baregl::types::ECullFace cullFace; };
+	struct SetViewportCommand { uint32_t x; uint32_t y; uint32_t width; uint32_t height; };
+	struct SetClearColorCommand { float red; float green; float blue; float alpha; };
+	struct ClearCommand { bool color; bool depth; bool stencil; };
+	struct DrawElementsCommand { baregl::types::EPrimitiveMode mode; baregl::types::EIndexType indexType; uint32_t count; uint32_t instances; uint32_t firstIndex; int32_t baseVertex; uint32_t baseInstance; };
+	struct DrawArraysCommand { baregl::types::EPrimitiveMode mode; uint32_t count; uint32_t instances; uint32_t firstVertex; uint32_t baseInstance; };
+	struct MultiDrawElementsIndirectCommand { const baregl::Buffer* buffer; uint64_t offset; baregl::types::EPrimitiveMode mode; baregl::types::EIndexType indexType; uint32_t drawCount; uint32_t stride; };
+	struct DispatchComputeCommand { uint32_t x; uint32_t y; uint32_t z; };
+	struct MemoryBarrierCommand { baregl::types::EMemoryBarrierFlags barriers; };
+
+	template<typename T>
+	struct SetUniformCommand { baregl::ShaderProgram* program; uint32_t location; T value; };
+
+	template<typename T>
+	constexpr ECommand UniformCommandFor()
+	{
+		using namespace baregl::math;
+		if constexpr (std::is_same_v<T, int>) return ECommand::SET_UNIFORM_INT;
+		else if constexpr (std::is_same_v<T, unsigned int>) return ECommand::SET_UNIFORM_UNSIGNED_INT;
+		else if constexpr (std::is_same_v<T, float>) return ECommand::SET_UNIFORM_FLOAT;
+		else if constexpr (std::is_same_v<T, Vec2>) return ECommand::SET_UNIFORM_VEC2;
+		else if constexpr (std::is_same_v<T, Vec3>) return ECommand::SET_UNIFORM_VEC3;
+		else if constexpr (std::is_same_v<T, Vec4>) return ECommand::SET_UNIFORM_VEC4;
+		else if constexpr (std::is_same_v<T, Mat3>) return ECommand::SET_UNIFORM_MAT3;
+		else return ECommand::SET_UNIFORM_MAT4;
+	}
+
+	template<typename T>
+	void Push(std::vector<std::byte>& p_arena, ECommand p_type, const T& p_payload)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Command payloads must be trivially copyable");
+
+		constexpr uint64_t unpaddedSize = sizeof(CommandHeader) + sizeof(T);
+		constexpr uint64_t size = (unpaddedSize + k_commandAlignment - 1) / k_commandAlignment * k_commandAlignment;
+
+		const CommandHeader header{ p_type, static_cast<uint32_t>(size) };
+
+		const size_t offset = p_arena.size();
+		p_arena.resize(offset + size);
+		std::memcpy(p_arena.data() + offset, &header, sizeof(CommandHeader));
+		std::memcpy(p_arena.data() + offset + sizeof(CommandHeader), &p_payload, sizeof(T));
+	}
+
+	template<typename T>
+	T Read(const std::byte* p_command)
+	{
+		T payload;
+		std::memcpy(&payload, p_command + sizeof(CommandHeader), sizeof(T));
+		return payload;
+	}
+
+	template<typename T>
+	void ReplayUniform(const std::byte* p_command)
+	{
+		const auto command = Read<SetUniformCommand<T>>(p_command);
+		command.program->SetUniform(command.location, command.value);
+	}
+}
+
+namespace baregl
+{
+	CommandList::CommandList(uint64_t p_reservedBytes)
+	{
+		m_arena.reserve(p_reservedBytes);
+	}
+
+	void CommandList::BindProgram(const ShaderProgram& p_program)
+	{
+		Push(m_arena, ECommand::BIND_PROGRAM, BindProgramCommand{ &p_program });
+		++m_commandCount;
+	}
+
+	void CommandList::BindVertexArray(const VertexArray& p_vertexArray)
+	{
+		Push(m_arena, ECommand::BIND_VERTEX_ARRAY, BindVertexArrayCommand{ &p_vertexArray });
+		++m_commandCount;
+	}
+
+	void CommandList::BindTexture(const Texture& p_texture, uint32_t p_slot)
+	{
+		Push(m_arena, ECommand::BIND_TEXTURE, BindTextureCommand{ &p_texture, p_slot });
+		++m_commandCount;
+	}
+
+	void CommandList::BindBuffer(Buffer& p_buffer, types::EBufferType p_type, std::optional<uint32_t> p_index)
+	{
+		Push(m_arena, ECommand::BIND_BUFFER, BindBufferCommand{ &p_buffer, p_type, p_index.has_value(), p_index.value_or(0) });
+		++m_commandCount;
+	}
+
+	void CommandList::BindBuffer(Buffer& p_buffer, types::EBufferType p_type, uint32_t p_index, data::BufferMemoryRange p_range)
+	{
+		Push(m_arena, ECommand::BIND_BUFFER_RANGE, BindBufferRangeCommand{ &p_buffer, p_type, p_index, p_range });
+		++m_commandCount;
+	}
+
+	template<SupportedUniformType T>
+	void CommandList::SetUniform(ShaderProgram& p_program, const std::string& p_name, const T& p_value)
+	{
+		if (const auto location = p_program.GetUniformLocation(p_name))
+		{
+			Push(m_arena, UniformCommandFor<T>(), SetUniformCommand<T>{ &p_program, location.value(), p_value });
+			++m_commandCount;
+		}
+	}
+
+	template void CommandList::SetUniform<int>(ShaderProgram&, const std::string&, const int&);
+	template void CommandList::SetUniform<unsigned int>(ShaderProgram&, const std::string&, const unsigned int&);
+	template void CommandList::SetUniform<float>(ShaderProgram&, const std::string&, const float&);
+	template void CommandList::SetUniform<math::Vec2>(ShaderProgram&, const std::string&, const math::Vec2&);
+	template void CommandList::SetUniform<math::Vec3>(ShaderProgram&, const std::string&, const math::Vec3&);
+	template void CommandList::SetUniform<math::Vec4>(ShaderProgram&, const std::string&, const math::Vec4&);
+	template void CommandList::SetUniform<math::Mat3>(ShaderProgram&, const std::string&, const math::Mat3&);
+	template void CommandList::SetUniform<math::Mat4>(ShaderProgram&, const std::string&, const math::Mat4&);
+
+	void CommandList::SetCapability(types::ERenderingCapability p_capability, bool p_value)
+	{
+		Push(m_arena, ECommand::SET_CAPABILITY, SetCapabilityCommand{ p_capability, p_value });
+		++m_commandCount;
+	}
+
+	void CommandList::SetDepthAlgorithm(types::EComparaisonAlgorithm p_algorithm)
+	{
+		Push(m_arena, ECommand::SET_DEPTH_ALGORITHM, SetDepthAlgorithmCommand{ p_algorithm });
+		++m_commandCount;
+	}
+
+	void CommandList::SetDepthWriting(bool p_enable)
+	{
+		Push(m_arena, ECommand::SET_DEPTH_WRITING, SetDepthWritingCommand{ p_enable });
+		++m_commandCount;
+	}
+
+	void CommandList::SetColorWriting(bool p_enableRed, bool p_enableGreen, bool p_enableBlue, bool p_enableAlpha)
+	{
+		Push(m_arena, ECommand::SET_COLOR_WRITING, SetColorWritingCommand{ p_enableRed, p_enableGreen, p_enableBlue, p_enableAlpha });
+		++m_commandCount;
+	}
+
+	void CommandList::SetBlendingFunction(types::EBlendingFactor p_sourceFactor, types::EBlendingFactor p_destinationFactor)
+	{
+		Push(m_arena, ECommand::SET_BLENDING_FUNCTION, SetBlendingFunctionCommand{ p_sourceFactor, p_destinationFactor });
+		++m_commandCount;
+	}
+
+	void CommandList::SetCullFace(types::ECullFace p_cullFace)
+	{
+		Push(m_arena, ECommand::SET_CULL_FACE, SetCullFaceCommand{ p_cullFace });
+		++m_commandCount;
+	}
+
+	void CommandList::SetViewport(uint32_t p_x, uint32_t p_y, uint32_t p_width, uint32_t p_height)
+	{
+		Push(m_arena, ECommand::SET_VIEWPORT, SetViewportCommand{ p_x, p_y, p_width, p_height });
+		++m_commandCount;
+	}
+
+	void CommandList::SetClearColor(float p_red, float p_green, float p_blue, float p_alpha)
+	{
+		Push(m_arena, ECommand::SET_CLEAR_COLOR, SetClearColorCommand{ p_red, p_green, p_blue, p_alpha });
+		++m_commandCount;
+	}
+
+	void CommandList::Clear(bool p_colorBuffer, bool p_depthBuffer, bool p_stencilBuffer)
+	{
+		Push(m_arena, ECommand::CLEAR, ClearCommand{ p_colorBuffer, p_depthBuffer, p_stencilBuffer });
+		++m_commandCount;
+	}
+
+	void CommandList::DrawElements(
+		types::EPrimitiveMode p_primitiveMode,
+		uint32_t p_indexCount,
+		types::EIndexType p_indexType,
+		uint32_t p_instances,
+		uint32_t p_firstIndex,
+		int32_t p_baseVertex,
+		uint32_t p_baseInstance
+	)
+	{
+		Push(m_arena, ECommand::DRAW_ELEMENTS, DrawElementsCommand{
+			p_primitiveMode,
+			p_indexType,
+			p_indexCount,
+			p_instances,
+			p_firstIndex,
+			p_baseVertex,
+			p_baseInstance
+		});
+		++m_commandCount;
+	}
+
+	void CommandList::DrawArrays(
+		types::EPrimitiveMode p_primitiveMode,
+		uint32_t p_vertexCount,
+		uint32_t p_instances,
+		uint32_t p_firstVertex,
+		uint32_t p_baseInstance
+	)
+	{
+		Push(m_arena, ECommand::DRAW_ARRAYS, DrawArraysCommand{
+			p_primitiveMode,
+			p_vertexCount,
+			p_instances,
+			p_firstVertex,
+			p_baseInstance
+		});
+		++m_commandCount;
+	}
+
+	void CommandList::MultiDrawElementsIndirect(
+		types::EPrimitiveMode p_primitiveMode,
+		const Buffer& p_commandBuffer,
+		uint32_t p_drawCount,
+		uint64_t p_offset,
+		uint32_t p_stride,
+		types::EIndexType p_indexType
+	)
+	{
+		Push(m_arena, ECommand::MULTI_DRAW_ELEMENTS_INDIRECT, MultiDrawElementsIndirectCommand{
+			&p_commandBuffer,
+			p_offset,
+			p_primitiveMode,
+			p_indexType,
+			p_drawCount,
+			p_stride
+		});
+		++m_commandCount;
+	}
+
+	void CommandList::DispatchCompute(uint32_t p_x, uint32_t p_y, uint32_t p_z)
+	{
+		Push(m_arena, ECommand::DISPATCH_COMPUTE, DispatchComputeCommand{ p_x, p_y, p_z });
+		++m_commandCount;
+	}
+
+	void CommandList::MemoryBarrier(types::EMemoryBarrierFlags p_barriers)
+	{
+		Push(m_arena, ECommand::MEMORY_BARRIER, MemoryBarrierCommand{ p_barriers });
+		++m_commandCount;
+	}
+
+	void CommandList::Execute(Context& p_context) const
+	{
+		const std::byte* command = m_arena.data();
+		const std::byte* end = command + m_arena.size();
+
+		while (command < end)
+		{
+			CommandHeader header;
+			std::memcpy(&header, command, sizeof(CommandHeader));
+
+			switch (header.type)
+			{
+			case ECommand::BIND_PROGRAM:
+			{
+				Read<BindProgramCommand>(command).program->Bind();
+				break;
+			}
+			case ECommand::BIND_VERTEX_ARRAY:
+			{
+				Read<BindVertexArrayCommand>(command).vertexArray->Bind();
+				break;
+			}
+			case ECommand::BIND_TEXTURE:
+			{
+				const auto bind = Read<BindTextureCommand>(command);
+				bind.texture->Bind(bind.slot);
+				break;
+			}
+			case ECommand::BIND_BUFFER:
+			{
+				const auto bind = Read<BindBufferCommand>(command);
+				bind.buffer->Bind(bind.type, bind.indexed ? std::optional<uint32_t>{ bind.index } : std::nullopt);
+				break;
+			}
+			case ECommand::BIND_BUFFER_RANGE:
+			{
+				const auto bind = Read<BindBufferRangeCommand>(command);
+				bind.buffer->Bind(bind.type, bind.index, bind.range);
+				break;
+			}
+			case ECommand::SET_UNIFORM_INT: ReplayUniform<int>(command); break;
+			case ECommand::SET_UNIFORM_UNSIGNED_INT: ReplayUniform<unsigned int>(command); break;
+			case ECommand::SET_UNIFORM_FLOAT: ReplayUniform<float>(command); break;
+			case ECommand::SET_UNIFORM_VEC2: ReplayUniform<math::Vec2>(command); break;
+			case ECommand::SET_UNIFORM_VEC3: ReplayUniform<math::Vec3>(command); break;
+			case ECommand::SET_UNIFORM_VEC4: ReplayUniform<math::Vec4>(command); break;
+			case ECommand::SET_UNIFORM_MAT3: ReplayUniform<math::Mat3>(command); break;
+			case ECommand::SET_UNIFORM_MAT4: ReplayUniform<math::Mat4>(command); break;
+			case ECommand::SET_CAPABILITY:
+			{
+				const auto state = Read<SetCapabilityCommand>(command);
+				p_context.SetCapability(state.capability, state.value);
+				break;
+			}
+			case ECommand::SET_DEPTH_ALGORITHM:
+			{
+				p_context.SetDepthAlgorithm(Read<SetDepthAlgorithmCommand>(command).algorithm);
+				break;
+			}
+			case ECommand::SET_DEPTH_WRITING:
+			{
+				p_context.SetDepthWriting(Read<SetDepthWritingCommand>(command).enable);
+				break;
+			}
+			case ECommand::SET_COLOR_WRITING:
+			{
+				const auto state = Read<SetColorWritingCommand>(command);
+				p_context.SetColorWriting(state.red, state.green, state.blue, state.alpha);
+				break;
+			}
+			case ECommand::SET_BLENDING_FUNCTION:
+			{
+				const auto state = Read<SetBlendingFunctionCommand>(command);
+				p_context.SetBlendingFunction(state.source, state.destination);
+				break;
+			}
+			case ECommand::SET_CULL_FACE:
+			{
+				p_context.SetCullFace(Read<SetCullFaceCommand>(command).cullFace);
+				break;
+			}
+			case ECommand::SET_VIEWPORT:
+			{
+				const auto state = Read<SetViewportCommand>(command);
+				p_context.SetViewport(state.x, state.y, state.width, state.height);
+				break;
+			}
+			case ECommand::SET_CLEAR_COLOR:
+			{
+				const auto state = Read<SetClearColorCommand>(command);
+				p_context.SetClearColor(state.red, state.green, state.blue, state.alpha);
+				break;
+			}
+			case ECommand::CLEAR:
+			{
+				const auto clear = Read<ClearCommand>(command);
+				p_context.Clear(clear.color, clear.depth, clear.stencil);
+				break;
+			}
+			case ECommand::DRAW_ELEMENTS:
+			{
+				const auto draw = Read<DrawElementsCommand>(command);
+				p_context.DrawElementsInstanced(
+					draw.mode,
+					draw.count,
+					draw.instances,
+					draw.indexType,
+					draw.firstIndex,
+					draw.baseVertex,
+					draw.baseInstance
+				);
+				break;
+			}
+			case ECommand::DRAW_ARRAYS:
+			{
+				const auto draw = Read<DrawArraysCommand>(command);
+				p_context.DrawArraysInstanced(draw.mode, draw.count, draw.instances, draw.firstVertex, draw.baseInstance);
+				break;
+			}
+			case ECommand::MULTI_DRAW_ELEMENTS_INDIRECT:
+			{
+				const auto draw = Read<MultiDrawElementsIndirectCommand>(command);
+				p_context.MultiDrawElementsIndirect(draw.mode, *draw.buffer, draw.drawCount, draw.offset, draw.stride, draw.indexType);
+				break;
+			}
+			case ECommand::DISPATCH_COMPUTE:
+			{
+				const auto dispatch = Read<DispatchComputeCommand>(command);
+				p_context.DispatchCompute(dispatch.x, dispatch.y, dispatch.z);
+				break;
+			}
+			case ECommand::MEMORY_BARRIER:
+			{
+				p_context.MemoryBarrier(Read<MemoryBarrierCommand>(command).barriers);
+				break;
+			}
+			default:
+			{
+				BAREGL_ASSERT(false, "Unknown command type");
+				break;
+			}
+			}
+
+			command += header.size;
+		}
+	}
+
+	void CommandList::Reset()
+	{
+		m_arena.clear();
+		m_commandCount = 0;
+	}
+
+	bool CommandList::IsEmpty() const
+	{
+		return m_commandCount == 0;
+	}
+
+	uint32_t CommandList::GetCommandCount() const
+	{
+		return m_commandCount;
+	}
+
+	uint64_t CommandList::GetSize() const
+	{
+		return m_arena.size();
+	}
+}
@@ -6,6 +6,7 @@
 
 #include <baregl/Context.h>
 
+#include <array>
 #include <concepts>
 #include <span>
 #include <vector>
@@ -13,16 +14,45 @@
 #include <baregl/debug/Assert.h>
 #include <baregl/debug/Log.h>
 #include <baregl/data/GetResultList.h>
+#include <baregl/detail/BufferTargets.h>
+#include <baregl/detail/PixelTransfer.h>
+#include <baregl/detail/StateCache.h>
 #include <baregl/detail/Types.h>
 #include <baregl/detail/glad/glad.h>
 #include <baregl/math/Conversions.h>
 #include <baregl/utils/BitmaskOperators.h>
 #include <baregl/utils/EnumMapper.h>
+#include <baregl/Buffer.h>
+#include <baregl/PipelineState.h>
 
 namespace
 {
 	uint32_t g_contextCount = 0u;
 
+	// Capacity of the stack storage used by BindBuffersRange, covers the indexed binding limits of common drivers
+	constexpr size_t k_maxBufferBindingsPerCall = 96;
+
+	uint32_t GetIndexSizeInBytes(baregl::types::EIndexType p_type)
+	{
+		switch (p_type)
+		{
+		case baregl::types::EIndexType::UNSIGNED_BYTE: return sizeof(GLubyte);
+		case baregl::types::EIndexType::UNSIGNED_SHORT: return sizeof(GLushort);
+		case baregl::types::EIndexType::UNSIGNED_INT: return sizeof(GLuint);
+		}
+
+		BAREGL_ASSERT(false, "Unsupported index type");
+		return 0;
+	}
+
+	template<class Command>
+	bool FitsIndirectCommands(const baregl::Buffer& p_buffer, uint64_t p_offset, uint32_t p_drawCount, uint32_t p_stride)
+	{
+		// A stride of 0 means tightly packed commands
+		const uint64_t stride = p_stride == 0 ? sizeof(Command) : p_stride;
+		return p_drawCount == 0 || p_offset + (p_drawCount - 1) * stride + sizeof(Command) <= p_buffer.GetSize();
+	}
+
 	void GLDebugMessageCallback(uint32_t p_source, uint32_t p_type, uint32_t p_id, uint32_t p_severity, int32_t p_length, const char* p_message, const void* p_userParam)
 	{
 		// Ignore non-significant error/warning codes
@@ -294,6 +324,9 @@ namespace baregl
 			return;
 		}
 
+		InvalidateStateCache();
+		ResetStateCacheStatistics();
+
 		BAREGL_LOG_INFO("BareGL context initialized.");
 	}
 
@@ -317,24 +350,216 @@ namespace baregl
 		}
 	}
 
+	void Context::ReadPixels(
+		uint32_t p_x,
+		uint32_t p_y,
+		uint32_t p_width,
+		uint32_t p_height,
+		types::EPixelDataFormat p_format,
+		types::EPixelDataType p_type,
+		void* p_data
+	)
+	{
+		BAREGL_ASSERT(p_width > 0 && p_height > 0, "Invalid read size");
+
+		detail::ReadPixels(p_x, p_y, p_width, p_height, p_format, p_type, p_data);
+	}
+
 	void Context::DrawElements(types::EPrimitiveMode p_primitiveMode, uint32_t p_indexCount)
 	{
 		glDrawElements(utils::EnumToValue<GLenum>(p_primitiveMode), p_indexCount, GL_UNSIGNED_INT, nullptr);
 	}
 
+	void Context::DrawElements(
+		types::EPrimitiveMode p_primitiveMode,
+		uint32_t p_indexCount,
+		types::EIndexType p_indexType,
+		uint32_t p_firstIndex,
+		int32_t p_baseVertex
+	)
+	{
+		glDrawElementsBaseVertex(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			p_indexCount,
+			utils::EnumToValue<GLenum>(p_indexType),
+			reinterpret_cast<const void*>(static_cast<uintptr_t>(p_firstIndex) * GetIndexSizeInBytes(p_indexType)),
+			p_baseVertex
+		);
+	}
+
 	void Context::DrawElementsInstanced(types::EPrimitiveMode p_primitiveMode, uint32_t p_indexCount, uint32_t p_instances)
 	{
 		glDrawElementsInstanced(utils::EnumToValue<GLenum>(p_primitiveMode), p_indexCount, GL_UNSIGNED_INT, nullptr, p_instances);
 	}
 
-	void Context::DrawArrays(types::EPrimitiveMode p_primitiveMode, uint32_t p_vertexCount)
+	void Context::DrawElementsInstanced(
+		types::EPrimitiveMode p_primitiveMode,
+		uint32_t p_indexCount,
+		uint32_t p_instances,
+		types::EIndexType p_indexType,
+		uint32_t p_firstIndex,
+		int32_t p_baseVertex,
+		uint32_t p_baseInstance
+	)
 	{
-		glDrawArrays(utils::EnumToValue<GLenum>(p_primitiveMode), 0, p_vertexCount);
+		glDrawElementsInstancedBaseVertexBaseInstance(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			p_indexCount,
+			utils::EnumToValue<GLenum>(p_indexType),
+			reinterpret_cast<const void*>(static_cast<uintptr_t>(p_firstIndex) * GetIndexSizeInBytes(p_indexType)),
+			p_instances,
+			p_baseVertex,
+			p_baseInstance
+		);
 	}
 
-	void Context::DrawArraysInstanced(types::EPrimitiveMode p_primitiveMode, uint32_t p_vertexCount, uint32_t p_instances)
+	void Context::DrawArrays(types::EPrimitiveMode p_primitiveMode, uint32_t p_vertexCount, uint32_t p_firstVertex)
 	{
-		glDrawArraysInstanced(utils::EnumToValue<GLenum>(p_primitiveMode), 0, p_vertexCount, p_instances);
+		glDrawArrays(utils::EnumToValue<GLenum>(p_primitiveMode), p_firstVertex, p_vertexCount);
+	}
+
+	void Context::DrawArraysInstanced(
+		types::EPrimitiveMode p_primitiveMode,
+		uint32_t p_vertexCount,
+		uint32_t p_instances,
+		uint32_t p_firstVertex,
+		uint32_t p_baseInstance
+	)
+	{
+		glDrawArraysInstancedBaseInstance(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			p_firstVertex,
+			p_vertexCount,
+			p_instances,
+			p_baseInstance
+		);
+	}
+
+	void Context::MultiDrawElementsIndirect(
+		types::EPrimitiveMode p_primitiveMode,
+		const Buffer& p_commandBuffer,
+		uint32_t p_drawCount,
+		uint64_t p_offset,
+		uint32_t p_stride,
+		types::EIndexType p_indexType
+	)
+	{
+		BAREGL_ASSERT(p_offset % sizeof(uint32_t) == 0, "Indirect command offset must be 4-byte aligned");
+		BAREGL_ASSERT(
+			FitsIndirectCommands<data::DrawElementsIndirectCommand>(p_commandBuffer, p_offset, p_drawCount, p_stride),
+			"Indirect draw commands exceed the buffer size"
+		);
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, p_commandBuffer.GetID());
+		glMultiDrawElementsIndirect(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			utils::EnumToValue<GLenum>(p_indexType),
+			reinterpret_cast<const void*>(p_offset),
+			p_drawCount,
+			p_stride
+		);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void Context::MultiDrawElementsIndirectCount(
+		types::EPrimitiveMode p_primitiveMode,
+		const Buffer& p_commandBuffer,
+		const Buffer& p_countBuffer,
+		uint64_t p_countOffset,
+		uint32_t p_maxDrawCount,
+		uint64_t p_offset,
+		uint32_t p_stride,
+		types::EIndexType p_indexType
+	)
+	{
+		BAREGL_ASSERT(IsIndirectCountSupported(), "Indirect draw count requires GL_ARB_indirect_parameters");
+		BAREGL_ASSERT(p_offset % sizeof(uint32_t) == 0, "Indirect command offset must be 4-byte aligned");
+		BAREGL_ASSERT(p_countOffset % sizeof(uint32_t) == 0, "Draw count offset must be 4-byte aligned");
+		BAREGL_ASSERT(
+			FitsIndirectCommands<data::DrawElementsIndirectCommand>(p_commandBuffer, p_offset, p_maxDrawCount, p_stride),
+			"Indirect draw commands exceed the buffer size"
+		);
+		BAREGL_ASSERT(
+			p_countOffset + sizeof(uint32_t) <= p_countBuffer.GetSize(),
+			"Indirect draw count exceeds the buffer size"
+		);
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, p_commandBuffer.GetID());
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, p_countBuffer.GetID());
+		glMultiDrawElementsIndirectCountARB(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			utils::EnumToValue<GLenum>(p_indexType),
+			reinterpret_cast<const void*>(p_offset),
+			static_cast<GLintptr>(p_countOffset),
+			p_maxDrawCount,
+			p_stride
+		);
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void Context::MultiDrawArraysIndirect(
+		types::EPrimitiveMode p_primitiveMode,
+		const Buffer& p_commandBuffer,
+		uint32_t p_drawCount,
+		uint64_t p_offset,
+		uint32_t p_stride
+	)
+	{
+		BAREGL_ASSERT(p_offset % sizeof(uint32_t) == 0, "Indirect command offset must be 4-byte aligned");
+		BAREGL_ASSERT(
+			FitsIndirectCommands<data::DrawArraysIndirectCommand>(p_commandBuffer, p_offset, p_drawCount, p_stride),
+			"Indirect draw commands exceed the buffer size"
+		);
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, p_commandBuffer.GetID());
+		glMultiDrawArraysIndirect(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			reinterpret_cast<const void*>(p_offset),
+			p_drawCount,
+			p_stride
+		);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void Context::MultiDrawArraysIndirectCount(
+		types::EPrimitiveMode p_primitiveMode,
+		const Buffer& p_commandBuffer,
+		const Buffer& p_countBuffer,
+		uint64_t p_countOffset,
+		uint32_t p_maxDrawCount,
+		uint64_t p_offset,
+		uint32_t p_stride
+	)
+	{
+		BAREGL_ASSERT(IsIndirectCountSupported(), "Indirect draw count requires GL_ARB_indirect_parameters");
+		BAREGL_ASSERT(p_offset % sizeof(uint32_t) == 0, "Indirect command offset must be 4-byte aligned");
+		BAREGL_ASSERT(p_countOffset % sizeof(uint32_t) == 0, "Draw count offset must be 4-byte aligned");
+		BAREGL_ASSERT(
+			FitsIndirectCommands<data::DrawArraysIndirectCommand>(p_commandBuffer, p_offset, p_maxDrawCount, p_stride),
+			"Indirect draw commands exceed the buffer size"
+		);
+		BAREGL_ASSERT(
+			p_countOffset + sizeof(uint32_t) <= p_countBuffer.GetSize(),
+			"Indirect draw count exceeds the buffer size"
+		);
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, p_commandBuffer.GetID());
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, p_countBuffer.GetID());
+		glMultiDrawArraysIndirectCountARB(
+			utils::EnumToValue<GLenum>(p_primitiveMode),
+			reinterpret_cast<const void*>(p_offset),
+			static_cast<GLintptr>(p_countOffset),
+			p_maxDrawCount,
+			p_stride
+		);
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	bool Context::IsIndirectCountSupported() const
+	{
+		return GLAD_GL_ARB_indirect_parameters != 0;
 	}
 
 	void Context::DispatchCompute(uint32_t p_x, uint32_t p_y, uint32_t p_z) const
@@ -347,6 +572,19 @@ namespace baregl
 		glDispatchCompute(p_x, p_y, p_z);
 	}
 
+	void Context::DispatchComputeIndirect(const Buffer& p_commandBuffer, uint64_t p_offset) const
+	{
+		BAREGL_ASSERT(p_offset % sizeof(uint32_t) == 0, "Indirect dispatch offset must be 4-byte aligned");
+		BAREGL_ASSERT(
+			p_offset + sizeof(data::DispatchIndirectCommand) <= p_commandBuffer.GetSize(),
+			"Indirect dispatch command exceeds the buffer size"
+		);
+
+		glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, p_commandBuffer.GetID());
+		glDispatchComputeIndirect(static_cast<GLintptr>(p_offset));
+		glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+	}
+
 	void Context::EnableDebugMessages()
 	{
 		glEnable(GL_DEBUG_OUTPUT);
@@ -368,6 +606,42 @@ namespace baregl
 		);
 	}
 
+	void Context::BindBuffersRange(
+		types::EBufferType p_type,
+		uint32_t p_firstIndex,
+		std::span<const data::BufferBinding> p_bindings
+	)
+	{
+		BAREGL_ASSERT(detail::IsIndexedBufferType(p_type), "Buffer type doesn't have indexed binding points");
+		BAREGL_ASSERT(!p_bindings.empty(), "Cannot bind an empty list of buffers");
+		BAREGL_ASSERT(p_bindings.size() <= k_maxBufferBindingsPerCall, "Too many buffers bound in a single call");
+
+		// Kept on the stack, this is meant to be called per draw
+		std::array<GLuint, k_maxBufferBindingsPerCall> buffers;
+		std::array<GLintptr, k_maxBufferBindingsPerCall> offsets;
+		std::array<GLsizeiptr, k_maxBufferBindingsPerCall> sizes;
+
+		for (size_t i = 0; i < p_bindings.size(); ++i)
+		{
+			const auto& [buffer, range] = p_bindings[i];
+
+			BAREGL_ASSERT(range.offset + range.size <= buffer.get().GetSize(), "Bound range exceeds the buffer size");
+
+			buffers[i] = buffer.get().GetID();
+			offsets[i] = static_cast<GLintptr>(range.offset);
+			sizes[i] = static_cast<GLsizeiptr>(range.size);
+		}
+
+		glBindBuffersRange(
+			utils::EnumToValue<GLenum>(p_type),
+			p_firstIndex,
+			static_cast<GLsizei>(p_bindings.size()),
+			buffers.data(),
+			offsets.data(),
+			sizes.data()
+		);
+	}
+
 	void Context::SetClearColor(float p_red, float p_green, float p_blue, float p_alpha)
 	{
 		glClearColor(p_red, p_green, p_blue, p_alpha);
@@ -375,17 +649,26 @@ namespace baregl
 
 	void Context::SetRasterizationLinesWidth(float p_width)
 	{
-		glLineWidth(p_width);
+		if (detail::GetStateCache().SetRasterizationLinesWidth(p_width))
+		{
+			glLineWidth(p_width);
+		}
 	}
 
 	void Context::SetRasterizationMode(types::ERasterizationMode p_rasterizationMode)
 	{
-		glPolygonMode(GL_FRONT_AND_BACK, utils::EnumToValue<GLenum>(p_rasterizationMode));
+		if (detail::GetStateCache().SetRasterizationMode(p_rasterizationMode))
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, utils::EnumToValue<GLenum>(p_rasterizationMode));
+		}
 	}
 
 	void Context::SetCapability(types::ERenderingCapability p_capability, bool p_value)
 	{
-		(p_value ? glEnable : glDisable)(utils::EnumToValue<GLenum>(p_capability));
+		if (detail::GetStateCache().SetCapability(p_capability, p_value))
+		{
+			(p_value ? glEnable : glDisable)(utils::EnumToValue<GLenum>(p_capability));
+		}
 	}
 
 	bool Context::GetCapability(types::ERenderingCapability p_capability)
@@ -395,59 +678,136 @@ namespace baregl
 
 	void Context::SetStencilAlgorithm(types::EComparaisonAlgorithm p_algorithm, int32_t p_reference, uint32_t p_mask)
 	{
-		glStencilFunc(utils::EnumToValue<GLenum>(p_algorithm), p_reference, p_mask);
+		if (detail::GetStateCache().SetStencilAlgorithm(p_algorithm, p_reference, p_mask))
+		{
+			glStencilFunc(utils::EnumToValue<GLenum>(p_algorithm), p_reference, p_mask);
+		}
 	}
 
 	void Context::SetDepthAlgorithm(types::EComparaisonAlgorithm p_algorithm)
 	{
-		glDepthFunc(utils::EnumToValue<GLenum>(p_algorithm));
+		if (detail::GetStateCache().SetDepthAlgorithm(p_algorithm))
+		{
+			glDepthFunc(utils::EnumToValue<GLenum>(p_algorithm));
+		}
 	}
 
 	void Context::SetStencilMask(uint32_t p_mask)
 	{
-		glStencilMask(p_mask);
+		if (detail::GetStateCache().SetStencilMask(p_mask))
+		{
+			glStencilMask(p_mask);
+		}
 	}
 
 	void Context::SetStencilOperations(types::EOperation p_stencilFail, types::EOperation p_depthFail, types::EOperation p_bothPass)
 	{
-		glStencilOp(
-			utils::EnumToValue<GLenum>(p_stencilFail),
-			utils::EnumToValue<GLenum>(p_depthFail),
-			utils::EnumToValue<GLenum>(p_bothPass)
-		);
+		if (detail::GetStateCache().SetStencilOperations(p_stencilFail, p_depthFail, p_bothPass))
+		{
+			glStencilOp(
+				utils::EnumToValue<GLenum>(p_stencilFail),
+				utils::EnumToValue<GLenum>(p_depthFail),
+				utils::EnumToValue<GLenum>(p_bothPass)
+			);
+		}
 	}
 
 	void Context::SetBlendingFunction(types::EBlendingFactor p_sourceFactor, types::EBlendingFactor p_destinationFactor)
 	{
-		glBlendFunc(
-			utils::EnumToValue<GLenum>(p_sourceFactor),
-			utils::EnumToValue<GLenum>(p_destinationFactor)
-		);
+		if (detail::GetStateCache().SetBlendingFunction(p_sourceFactor, p_destinationFactor))
+		{
+			glBlendFunc(
+				utils::EnumToValue<GLenum>(p_sourceFactor),
+				utils::EnumToValue<GLenum>(p_destinationFactor)
+			);
+		}
 	}
 
 	void Context::SetBlendingEquation(types::EBlendingEquation p_equation)
 	{
-		glBlendEquation(utils::EnumToValue<GLenum>(p_equation));
+		if (detail::GetStateCache().SetBlendingEquation(p_equation))
+		{
+			glBlendEquation(utils::EnumToValue<GLenum>(p_equation));
+		}
 	}
 
 	void Context::SetCullFace(types::ECullFace p_cullFace)
 	{
-		glCullFace(utils::EnumToValue<GLenum>(p_cullFace));
+		if (detail::GetStateCache().SetCullFace(p_cullFace))
+		{
+			glCullFace(utils::EnumToValue<GLenum>(p_cullFace));
+		}
 	}
 
 	void Context::SetDepthWriting(bool p_enable)
 	{
-		glDepthMask(p_enable);
+		if (detail::GetStateCache().SetDepthWriting(p_enable))
+		{
+			glDepthMask(p_enable);
+		}
 	}
 
 	void Context::SetColorWriting(bool p_enableRed, bool p_enableGreen, bool p_enableBlue, bool p_enableAlpha)
 	{
-		glColorMask(p_enableRed, p_enableGreen, p_enableBlue, p_enableAlpha);
+		if (detail::GetStateCache().SetColorWriting(p_enableRed, p_enableGreen, p_enableBlue, p_enableAlpha))
+		{
+			glColorMask(p_enableRed, p_enableGreen, p_enableBlue, p_enableAlpha);
+		}
 	}
 
 	void Context::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		if (detail::GetStateCache().SetViewport(x, y, width, height))
+		{
+			glViewport(x, y, width, height);
+		}
+	}
+
+	void Context::SetPipelineState(const PipelineState& p_pipelineState)
+	{
+		auto& stateCache = detail::GetStateCache();
+
+		if (stateCache.IsPipelineStateApplied(p_pipelineState.GetID()))
+		{
+			return;
+		}
+
+		using enum types::ERenderingCapability;
+
+		// Every setter goes through the state cache, so only the fields that differ reach the driver
+		const auto& desc = p_pipelineState.GetDesc();
+		SetCapability(BLEND, desc.blending);
+		SetBlendingFunction(desc.blendingSourceFactor, desc.blendingDestinationFactor);
+		SetBlendingEquation(desc.blendingEquation);
+		SetCapability(DEPTH_TEST, desc.depthTest);
+		SetDepthWriting(desc.depthWriting);
+		SetDepthAlgorithm(desc.depthAlgorithm);
+		SetCapability(STENCIL_TEST, desc.stencilTest);
+		SetStencilAlgorithm(desc.stencilAlgorithm, desc.stencilReference, desc.stencilAlgorithmMask);
+		SetStencilMask(desc.stencilWriteMask);
+		SetStencilOperations(desc.stencilFailOperation, desc.depthFailOperation, desc.bothPassOperation);
+		SetCapability(CULL_FACE, desc.culling);
+		SetCullFace(desc.cullFace);
+		SetRasterizationMode(desc.rasterizationMode);
+		SetRasterizationLinesWidth(desc.lineWidth);
+		SetColorWriting(desc.colorWritingRed, desc.colorWritingGreen, desc.colorWritingBlue, desc.colorWritingAlpha);
+
+		stateCache.SetAppliedPipelineState(p_pipelineState.GetID());
+	}
+
+	void Context::InvalidateStateCache()
+	{
+		detail::GetStateCache().Invalidate();
+	}
+
+	data::StateCacheStatistics Context::GetStateCacheStatistics() const
+	{
+		return detail::GetStateCache().GetStatistics();
+	}
+
+	void Context::ResetStateCacheStatistics()
+	{
+		detail::GetStateCache().ResetStatistics();
 	}
 
 	template<auto PName>
@@ -0,0 +1,92 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/CopyQueue.h>
+
+#include <baregl/debug/Assert.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace baregl
+{
+	void CopyQueue::Enqueue(const Buffer& p_source, Buffer& p_destination, const data::BufferCopyRegion& p_region)
+	{
+		BAREGL_ASSERT(p_region.size > 0, "Cannot queue an empty copy");
+
+		m_copies.push_back({ &p_source, &p_destination, p_region });
+		m_pendingBytes += p_region.size;
+	}
+
+	uint32_t CopyQueue::Submit()
+	{
+		if (m_copies.empty())
+		{
+			return 0;
+		}
+
+		// Sorting by buffer pair then by offset puts the copies that can be merged next to each other
+		std::sort(m_copies.begin(), m_copies.end(), [](const Copy& p_a, const Copy& p_b)
+		{
+			return
+				std::tuple(p_a.source->GetID(), p_a.destination->GetID(), p_a.region.sourceOffset) <
+				std::tuple(p_b.source->GetID(), p_b.destination->GetID(), p_b.region.sourceOffset);
+		});
+
+		uint32_t commandCount = 0;
+		Copy pending = m_copies.front();
+
+		for (auto it = std::next(m_copies.begin()); it != m_copies.end(); ++it)
+		{
+			const bool contiguous =
+				it->source == pending.source &&
+				it->destination == pending.destination &&
+				it->region.sourceOffset == pending.region.sourceOffset + pending.region.size &&
+				it->region.destinationOffset == pending.region.destinationOffset + pending.region.size;
+
+			// Within a single buffer, merging must not produce overlapping source and destination ranges
+			const uint64_t mergedSize = pending.region.size + it->region.size;
+			const bool overlapping =
+				pending.source == pending.destination &&
+				pending.region.sourceOffset < pending.region.destinationOffset + mergedSize &&
+				pending.region.destinationOffset < pending.region.sourceOffset + mergedSize;
+
+			if (contiguous && !overlapping)
+			{
+				pending.region.size += it->region.size;
+			}
+			else
+			{
+				pending.destination->CopyFrom(*pending.source, pending.region.sourceOffset, pending.region.destinationOffset, pending.region.size);
+				++commandCount;
+				pending = *it;
+			}
+		}
+
+		pending.destination->CopyFrom(*pending.source, pending.region.sourceOffset, pending.region.destinationOffset, pending.region.size);
+		++commandCount;
+
+		Reset();
+
+		return commandCount;
+	}
+
+	void CopyQueue::Reset()
+	{
+		m_copies.clear();
+		m_pendingBytes = 0;
+	}
+
+	uint32_t CopyQueue::GetPendingCount() const
+	{
+		return static_cast<uint32_t>(m_copies.size());
+	}
+
+	uint64_t CopyQueue::GetPendingBytes() const
+	{
+		return m_pendingBytes;
+	}
+}
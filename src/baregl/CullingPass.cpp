@@ -0,0 +1,231 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/CullingPass.h>
+
+#include <baregl/debug/Assert.h>
+#include <baregl/debug/Log.h>
+
+#include <array>
+
+namespace
+{
+	constexpr uint32_t k_depthPyramidSlot = 0;
+
+	constexpr const char* k_cullingShaderSource = R"(
+#version 450 core
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+struct DrawCommand
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+layout(std430, binding = 0) restrict readonly buffer Bounds { vec4 bounds[]; };
+layout(std430, binding = 1) restrict readonly buffer InputCommands { DrawCommand inputCommands[]; };
+layout(std430, binding = 2) restrict writeonly buffer OutputCommands { DrawCommand outputCommands[]; };
+layout(std430, binding = 3) restrict buffer VisibleCount { uint visibleCount; };
+
+uniform mat4 u_ViewProjection;
+uniform uint u_InstanceCount;
+uniform int u_UseDepthPyramid;
+uniform sampler2D u_DepthPyramid;
+
+bool IsInsideFrustum(vec3 center, float radius)
+{
+	const vec4 row0 = vec4(u_ViewProjection[0][0], u_ViewProjection[1][0], u_ViewProjection[2][0], u_ViewProjection[3][0]);
+	const vec4 row1 = vec4(u_ViewProjection[0][1], u_ViewProjection[1][1], u_ViewProjection[2][1], u_ViewProjection[3][1]);
+	const vec4 row2 = vec4(u_ViewProjection[0][2], u_ViewProjection[1][2], u_ViewProjection[2][2], u_ViewProjection[3][2]);
+	const vec4 row3 = vec4(u_ViewProjection[0][3], u_ViewProjection[1][3], u_ViewProjection[2][3], u_ViewProjection[3][3]);
+
+	const vec4 planes[6] = vec4[6](row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2);
+
+	for (int i = 0; i < 6; ++i)
+	{
+		const vec4 plane = planes[i] / length(planes[i].xyz);
+
+		if (dot(plane.xyz, center) + plane.w < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool IsOccluded(vec3 center, float radius)
+{
+	vec3 minimum = vec3(1.0);
+	vec3 maximum = vec3(0.0);
+
+	// Screen space bounds of the sphere, from the corners of its bounding box
+	for (int i = 0; i < 8; ++i)
+	{
+		const vec3 corner = center + radius * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+		const vec4 clip = u_ViewProjection * vec4(corner, 1.0);
+
+		// Crossing the near plane, can't be reliably projected
+		if (clip.w <= 0.0)
+		{
+			return false;
+		}
+
+		const vec3 ndc = clip.xyz / clip.w * 0.5 + 0.5;
+		minimum = min(minimum, ndc);
+		maximum = max(maximum, ndc);
+	}
+
+	minimum.xy = clamp(minimum.xy, 0.0, 1.0);
+	maximum.xy = clamp(maximum.xy, 0.0, 1.0);
+
+	// Pick the level where the bounds cover at most 2x2 texels, clamped to the last level of the pyramid
+	const vec2 extent = (maximum.xy - minimum.xy) * vec2(textureSize(u_DepthPyramid, 0));
+	const int level = min(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), textureQueryLevels(u_DepthPyramid) - 1);
+
+	// Texels are fetched rather than sampled, so that filtering never blends in depths from outside the bounds
+	const ivec2 size = textureSize(u_DepthPyramid, level);
+	const ivec2 lower = clamp(ivec2(minimum.xy * vec2(size)), ivec2(0), size - 1);
+	const ivec2 upper = clamp(ivec2(maximum.xy * vec2(size)), ivec2(0), size - 1);
+
+	// The pyramid is too short for the bounds to fit in 2x2 texels, conservatively treat as visible
+	if (any(greaterThan(upper - lower, ivec2(1))))
+	{
+		return false;
+	}
+
+	const float farthestDepth = max(
+		max(texelFetch(u_DepthPyramid, lower, level).r, texelFetch(u_DepthPyramid, ivec2(upper.x, lower.y), level).r),
+		max(texelFetch(u_DepthPyramid, ivec2(lower.x, upper.y), level).r, texelFetch(u_DepthPyramid, upper, level).r)
+	);
+
+	return minimum.z > farthestDepth;
+}
+
+void main()
+{
+	const uint index = gl_GlobalInvocationID.x;
+
+	if (index >= u_InstanceCount)
+	{
+		return;
+	}
+
+	const vec3 center = bounds[index].xyz;
+	const float radius = bounds[index].w;
+
+	if (!IsInsideFrustum(center, radius) || (u_UseDepthPyramid != 0 && IsOccluded(center, radius)))
+	{
+		return;
+	}
+
+	const uint slot = atomicAdd(visibleCount, 1u);
+	outputCommands[slot] = inputCommands[index];
+	outputCommands[slot].baseInstance = index;
+}
+)";
+}
+
+namespace baregl
+{
+	CullingPass::CullingPass(uint32_t p_maxInstanceCount) :
+		m_shader(types::EShaderType::COMPUTE),
+		m_maxInstanceCount{ p_maxInstanceCount }
+	{
+		BAREGL_ASSERT(p_maxInstanceCount > 0, "Culling pass requires at least one instance");
+
+		m_shader.Upload(k_cullingShaderSource);
+
+		if (const auto result = m_shader.Compile(); !result.success)
+		{
+			BAREGL_LOG_ERROR("Failed to compile the culling shader: " + result.message);
+		}
+
+		m_program.Attach(m_shader);
+
+		if (const auto result = m_program.Link(); !result.success)
+		{
+			BAREGL_LOG_ERROR("Failed to link the culling program: " + result.message);
+		}
+
+		// Queried once, instead of on every dispatch
+		m_workGroupSize = m_program.GetComputeWorkGroupSize()[0];
+
+		m_commandBuffer.Allocate(
+			p_maxInstanceCount * sizeof(data::DrawElementsIndirectCommand),
+			types::EBufferStorageFlags::NONE
+		);
+
+		m_countBuffer.Allocate(sizeof(uint32_t), types::EBufferStorageFlags::NONE);
+	}
+
+	void CullingPass::Execute(
+		Context& p_context,
+		const Buffer& p_bounds,
+		const Buffer& p_drawCommands,
+		uint32_t p_instanceCount,
+		const math::Mat4& p_viewProjection,
+		std::optional<std::reference_wrapper<const Texture>> p_depthPyramid
+	)
+	{
+		BAREGL_ASSERT(p_instanceCount <= m_maxInstanceCount, "Too many instances for this culling pass");
+		BAREGL_ASSERT(p_bounds.GetSize() >= p_instanceCount * sizeof(data::BoundingSphere), "Bounds buffer is too small");
+		BAREGL_ASSERT(p_drawCommands.GetSize() >= p_instanceCount * sizeof(data::DrawElementsIndirectCommand), "Draw commands buffer is too small");
+
+		m_countBuffer.Clear();
+
+		if (p_instanceCount == 0)
+		{
+			return;
+		}
+
+		const auto bindings = std::to_array<data::BufferBinding>({
+			{ p_bounds, { .offset = 0, .size = p_bounds.GetSize() } },
+			{ p_drawCommands, { .offset = 0, .size = p_drawCommands.GetSize() } },
+			{ m_commandBuffer, { .offset = 0, .size = m_commandBuffer.GetSize() } },
+			{ m_countBuffer, { .offset = 0, .size = m_countBuffer.GetSize() } }
+		});
+
+		p_context.BindBuffersRange(types::EBufferType::SHADER_STORAGE, 0, bindings);
+
+		m_program.Bind();
+		m_program.SetUniform("u_ViewProjection", p_viewProjection);
+		m_program.SetUniform("u_InstanceCount", p_instanceCount);
+		m_program.SetUniform("u_UseDepthPyramid", p_depthPyramid.has_value() ? 1 : 0);
+
+		if (p_depthPyramid.has_value())
+		{
+			p_depthPyramid->get().Bind(k_depthPyramidSlot);
+			m_program.SetUniform("u_DepthPyramid", static_cast<int>(k_depthPyramidSlot));
+		}
+
+		BAREGL_ASSERT(m_workGroupSize > 0, "Culling program doesn't have a valid compute work group size");
+		p_context.DispatchCompute((p_instanceCount + m_workGroupSize - 1) / m_workGroupSize, 1, 1);
+
+		m_program.Unbind();
+
+		// The outputs are consumed as draw-indirect parameters, or by other shaders
+		p_context.MemoryBarrier(types::EMemoryBarrierFlags::COMMAND | types::EMemoryBarrierFlags::SHADER_STORAGE);
+	}
+
+	const Buffer& CullingPass::GetCommandBuffer() const
+	{
+		return m_commandBuffer;
+	}
+
+	const Buffer& CullingPass::GetCountBuffer() const
+	{
+		return m_countBuffer;
+	}
+
+	uint32_t CullingPass::GetMaxInstanceCount() const
+	{
+		return m_maxInstanceCount;
+	}
+}
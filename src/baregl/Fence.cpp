@@ -0,0 +1,95 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/Fence.h>
+
+#include <baregl/debug/Log.h>
+#include <baregl/detail/glad/glad.h>
+
+#include <utility>
+
+namespace
+{
+	GLsync ToNative(void* p_sync)
+	{
+		return static_cast<GLsync>(p_sync);
+	}
+}
+
+namespace baregl
+{
+	Fence::~Fence()
+	{
+		Reset();
+	}
+
+	Fence::Fence(Fence&& p_other) noexcept :
+		m_sync{ std::exchange(p_other.m_sync, nullptr) }
+	{
+	}
+
+	Fence& Fence::operator=(Fence&& p_other) noexcept
+	{
+		if (this != &p_other)
+		{
+			Reset();
+			m_sync = std::exchange(p_other.m_sync, nullptr);
+		}
+
+		return *this;
+	}
+
+	void Fence::Insert()
+	{
+		Reset();
+		m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void Fence::Reset()
+	{
+		if (m_sync)
+		{
+			glDeleteSync(ToNative(m_sync));
+			m_sync = nullptr;
+		}
+	}
+
+	bool Fence::IsInserted() const
+	{
+		return m_sync != nullptr;
+	}
+
+	bool Fence::IsSignaled() const
+	{
+		if (!m_sync)
+		{
+			return true;
+		}
+
+		GLint status = GL_UNSIGNALED;
+		glGetSynciv(ToNative(m_sync), GL_SYNC_STATUS, 1, nullptr, &status);
+		return status == GL_SIGNALED;
+	}
+
+	bool Fence::Wait(uint64_t p_timeout) const
+	{
+		if (!m_sync)
+		{
+			return true;
+		}
+
+		// Flushing makes sure the fence actually reaches the GPU, otherwise waiting on it could deadlock
+		const GLenum result = glClientWaitSync(ToNative(m_sync), GL_SYNC_FLUSH_COMMANDS_BIT, p_timeout);
+
+		if (result == GL_WAIT_FAILED)
+		{
+			BAREGL_LOG_ERROR("Failed to wait on fence");
+			return false;
+		}
+
+		return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+	}
+}
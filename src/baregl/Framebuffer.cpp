@@ -10,6 +10,7 @@
 #include <baregl/debug/Event.h>
 #include <baregl/debug/Log.h>
 #include <baregl/detail/glad/glad.h>
+#include <baregl/detail/PixelTransfer.h>
 #include <baregl/detail/Types.h>
 #include <baregl/Renderbuffer.h>
 
@@ -249,14 +250,7 @@ namespace baregl
 		BAREGL_ASSERT(p_width > 0 && p_height > 0, "Invalid read size");
 
 		Bind();
-		glReadPixels(
-			p_x, p_y,
-			p_width,
-			p_height,
-			utils::EnumToValue<GLenum>(p_format),
-			utils::EnumToValue<GLenum>(p_type),
-			p_data
-		);
+		detail::ReadPixels(p_x, p_y, p_width, p_height, p_format, p_type, p_data);
 		Unbind();
 	}
 
@@ -0,0 +1,114 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/PipelineState.h>
+
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace
+{
+	auto Tie(const baregl::data::PipelineStateDesc& p_desc)
+	{
+		return std::tie(
+			p_desc.blending,
+			p_desc.blendingSourceFactor,
+			p_desc.blendingDestinationFactor,
+			p_desc.blendingEquation,
+			p_desc.depthTest,
+			p_desc.depthWriting,
+			p_desc.depthAlgorithm,
+			p_desc.stencilTest,
+			p_desc.stencilAlgorithm,
+			p_desc.stencilReference,
+			p_desc.stencilAlgorithmMask,
+			p_desc.stencilWriteMask,
+			p_desc.stencilFailOperation,
+			p_desc.depthFailOperation,
+			p_desc.bothPassOperation,
+			p_desc.culling,
+			p_desc.cullFace,
+			p_desc.rasterizationMode,
+			p_desc.lineWidth,
+			p_desc.colorWritingRed,
+			p_desc.colorWritingGreen,
+			p_desc.colorWritingBlue,
+			p_desc.colorWritingAlpha
+		);
+	}
+
+	uint64_t Hash(const baregl::data::PipelineStateDesc& p_desc)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		std::apply([&hash](const auto&... p_fields) {
+			((hash = (hash ^ std::hash<std::decay_t<decltype(p_fields)>>{}(p_fields)) * 1099511628211ull), ...);
+		}, Tie(p_desc));
+
+		return hash;
+	}
+
+	struct DescHash
+	{
+		size_t operator()(const baregl::data::PipelineStateDesc& p_desc) const
+		{
+			return static_cast<size_t>(Hash(p_desc));
+		}
+	};
+
+	struct DescEqual
+	{
+		bool operator()(const baregl::data::PipelineStateDesc& p_lhs, const baregl::data::PipelineStateDesc& p_rhs) const
+		{
+			return Tie(p_lhs) == Tie(p_rhs);
+		}
+	};
+
+	// Pipeline states can be created from any thread, so the intern table is guarded
+	std::mutex g_internMutex;
+	std::unordered_map<baregl::data::PipelineStateDesc, uint32_t, DescHash, DescEqual> g_internedDescs;
+
+	uint32_t Intern(const baregl::data::PipelineStateDesc& p_desc)
+	{
+		std::scoped_lock lock(g_internMutex);
+
+		// IDs start at 1, so that 0 can stand for "no pipeline state applied"
+		const auto [it, inserted] = g_internedDescs.try_emplace(p_desc, static_cast<uint32_t>(g_internedDescs.size() + 1));
+		return it->second;
+	}
+}
+
+namespace baregl
+{
+	PipelineState::PipelineState(const data::PipelineStateDesc& p_desc) :
+		m_desc{ p_desc },
+		m_hash{ Hash(p_desc) },
+		m_id{ Intern(p_desc) }
+	{
+	}
+
+	const data::PipelineStateDesc& PipelineState::GetDesc() const
+	{
+		return m_desc;
+	}
+
+	uint64_t PipelineState::GetHash() const
+	{
+		return m_hash;
+	}
+
+	uint32_t PipelineState::GetID() const
+	{
+		return m_id;
+	}
+
+	bool PipelineState::operator==(const PipelineState& p_other) const
+	{
+		return m_id == p_other.m_id;
+	}
+}
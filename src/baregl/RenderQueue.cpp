@@ -0,0 +1,242 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/RenderQueue.h>
+
+#include <baregl/debug/Assert.h>
+#include <baregl/detail/glad/glad.h>
+#include <baregl/detail/StateCache.h>
+#include <baregl/Context.h>
+#include <baregl/PipelineState.h>
+#include <baregl/ShaderProgram.h>
+#include <baregl/Texture.h>
+#include <baregl/VertexArray.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <utility>
+
+namespace
+{
+	// Bit layout of the sort key, from the most significant field to the least significant one
+	constexpr uint32_t k_passBits = 4;
+	constexpr uint32_t k_programBits = 12;
+	constexpr uint32_t k_pipelineStateBits = 10;
+	constexpr uint32_t k_vertexArrayBits = 10;
+	constexpr uint32_t k_textureBits = 12;
+	constexpr uint32_t k_depthBits = 16;
+
+	static_assert(k_passBits + k_programBits + k_pipelineStateBits + k_vertexArrayBits + k_textureBits + k_depthBits == 64);
+
+	constexpr uint32_t k_radixBits = 8;
+	constexpr uint32_t k_radixBuckets = 1 << k_radixBits;
+	constexpr uint32_t k_radixPasses = 64 / k_radixBits;
+
+	constexpr uint64_t Field(uint64_t p_value, uint32_t p_bits)
+	{
+		return p_value & ((uint64_t{ 1 } << p_bits) - 1);
+	}
+
+	const baregl::PipelineState& GetDefaultPipelineState()
+	{
+		static const baregl::PipelineState defaultPipelineState;
+		return defaultPipelineState;
+	}
+
+	const baregl::PipelineState& GetPipelineState(const baregl::data::DrawPacket& p_packet)
+	{
+		return p_packet.pipelineState ? *p_packet.pipelineState : GetDefaultPipelineState();
+	}
+
+	void BindTextureUnit(uint32_t p_slot, const baregl::Texture* p_texture)
+	{
+		if (p_texture)
+		{
+			p_texture->Bind(p_slot);
+		}
+		else if (baregl::detail::GetStateCache().BindTextureUnit(p_slot, 0))
+		{
+			glBindTextureUnit(p_slot, 0);
+		}
+	}
+
+	uint64_t QuantizeDepth(float p_depth)
+	{
+		// The bit pattern of a non-negative float grows with its value, so its upper bits can be compared as an integer
+		return std::bit_cast<uint32_t>(std::max(p_depth, 0.0f)) >> (32 - k_depthBits);
+	}
+}
+
+namespace baregl
+{
+	RenderQueue::RenderQueue(uint32_t p_reservedPackets)
+	{
+		m_packets.reserve(p_reservedPackets);
+		m_entries.reserve(p_reservedPackets);
+		m_scratch.reserve(p_reservedPackets);
+	}
+
+	void RenderQueue::Enqueue(const data::DrawPacket& p_packet)
+	{
+		BAREGL_ASSERT(p_packet.program != nullptr, "A draw packet requires a program");
+		BAREGL_ASSERT(p_packet.vertexArray != nullptr, "A draw packet requires a vertex array");
+
+		m_entries.push_back({ CalculateSortKey(p_packet), static_cast<uint32_t>(m_packets.size()) });
+		m_packets.push_back(p_packet);
+		m_sorted = false;
+	}
+
+	void RenderQueue::Sort()
+	{
+		if (m_sorted)
+		{
+			return;
+		}
+
+		const size_t count = m_entries.size();
+		m_scratch.resize(count);
+
+		// Building every histogram up front takes a single read of the keys
+		std::array<std::array<uint32_t, k_radixBuckets>, k_radixPasses> histograms{};
+
+		for (const auto& entry : m_entries)
+		{
+			for (uint32_t pass = 0; pass < k_radixPasses; ++pass)
+			{
+				++histograms[pass][(entry.key >> (pass * k_radixBits)) & (k_radixBuckets - 1)];
+			}
+		}
+
+		for (uint32_t pass = 0; pass < k_radixPasses; ++pass)
+		{
+			auto& histogram = histograms[pass];
+			const uint32_t shift = pass * k_radixBits;
+
+			// Every key shares the same digit, nothing to reorder
+			if (histogram[(m_entries.front().key >> shift) & (k_radixBuckets - 1)] == count)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (auto& bucket : histogram)
+			{
+				offset += std::exchange(bucket, offset);
+			}
+
+			for (const auto& entry : m_entries)
+			{
+				m_scratch[histogram[(entry.key >> shift) & (k_radixBuckets - 1)]++] = entry;
+			}
+
+			m_entries.swap(m_scratch);
+		}
+
+		m_sorted = true;
+	}
+
+	uint32_t RenderQueue::Submit(Context& p_context)
+	{
+		Sort();
+
+		const ShaderProgram* program = nullptr;
+		const PipelineState* pipelineState = nullptr;
+		const VertexArray* vertexArray = nullptr;
+		std::array<const Texture*, data::DrawPacket::k_maxTextures> textures{};
+
+		for (const auto& entry : m_entries)
+		{
+			const auto& packet = m_packets[entry.index];
+
+			if (packet.program != program)
+			{
+				program = packet.program;
+				program->Bind();
+			}
+
+			if (const auto& packetPipelineState = GetPipelineState(packet); &packetPipelineState != pipelineState)
+			{
+				pipelineState = &packetPipelineState;
+				p_context.SetPipelineState(*pipelineState);
+			}
+
+			if (packet.vertexArray != vertexArray)
+			{
+				vertexArray = packet.vertexArray;
+				vertexArray->Bind();
+			}
+
+			// Empty slots are unbound, so that a packet never samples the textures of the one before it
+			for (uint32_t slot = 0; slot < data::DrawPacket::k_maxTextures; ++slot)
+			{
+				if (&entry == &m_entries.front() || packet.textures[slot] != textures[slot])
+				{
+					textures[slot] = packet.textures[slot];
+					BindTextureUnit(slot, textures[slot]);
+				}
+			}
+
+			if (packet.indexed)
+			{
+				p_context.DrawElementsInstanced(
+					packet.primitiveMode,
+					packet.count,
+					packet.instances,
+					packet.indexType,
+					packet.first,
+					packet.baseVertex,
+					packet.baseInstance
+				);
+			}
+			else
+			{
+				p_context.DrawArraysInstanced(packet.primitiveMode, packet.count, packet.instances, packet.first, packet.baseInstance);
+			}
+		}
+
+		const uint32_t drawCount = static_cast<uint32_t>(m_entries.size());
+		Reset();
+		return drawCount;
+	}
+
+	void RenderQueue::Reset()
+	{
+		m_packets.clear();
+		m_entries.clear();
+		m_sorted = true;
+	}
+
+	uint32_t RenderQueue::GetPendingCount() const
+	{
+		return static_cast<uint32_t>(m_packets.size());
+	}
+
+	uint64_t RenderQueue::GetPendingKey(uint32_t p_index) const
+	{
+		BAREGL_ASSERT(p_index < m_entries.size(), "Pending packet index out of range");
+		return m_entries[p_index].key;
+	}
+
+	uint64_t RenderQueue::CalculateSortKey(const data::DrawPacket& p_packet)
+	{
+		BAREGL_ASSERT(p_packet.pass < (1 << k_passBits), "Draw packet pass out of range");
+
+		// Object IDs are truncated, distinct objects may collide, which only costs an extra bind
+		const uint64_t program = p_packet.program ? p_packet.program->GetID() : 0;
+		const uint64_t pipelineState = GetPipelineState(p_packet).GetID();
+		const uint64_t vertexArray = p_packet.vertexArray ? p_packet.vertexArray->GetID() : 0;
+		const uint64_t texture = p_packet.textures[0] ? p_packet.textures[0]->GetID() : 0;
+
+		uint64_t key = Field(p_packet.pass, k_passBits);
+		key = (key << k_programBits) | Field(program, k_programBits);
+		key = (key << k_pipelineStateBits) | Field(pipelineState, k_pipelineStateBits);
+		key = (key << k_vertexArrayBits) | Field(vertexArray, k_vertexArrayBits);
+		key = (key << k_textureBits) | Field(texture, k_textureBits);
+		key = (key << k_depthBits) | QuantizeDepth(p_packet.depth);
+		return key;
+	}
+}
@@ -10,6 +10,7 @@
 #include <baregl/debug/Event.h>
 #include <baregl/debug/Log.h>
 #include <baregl/detail/glad/glad.h>
+#include <baregl/detail/StateCache.h>
 #include <baregl/detail/Types.h>
 #include <baregl/Texture.h>
 
@@ -28,17 +29,24 @@ namespace baregl
 	ShaderProgram::~ShaderProgram()
 	{
 		glDeleteProgram(m_id);
+		detail::GetStateCache().ForgetProgram(m_id);
 		NOTIFY_SHADER_PROGRAM_DESTROYED;
 	}
 
 	void ShaderProgram::Bind() const
 	{
-		glUseProgram(m_id);
+		if (detail::GetStateCache().BindProgram(m_id))
+		{
+			glUseProgram(m_id);
+		}
 	}
 
 	void ShaderProgram::Unbind() const
 	{
-		glUseProgram(0);
+		if (detail::GetStateCache().BindProgram(0))
+		{
+			glUseProgram(0);
+		}
 	}
 
 	void ShaderProgram::Attach(const ShaderStage& p_shader)
@@ -118,7 +126,7 @@ type ShaderProgram::GetUniform<type>(const std::string& p_name) \
 	DECLARE_GET_UNIFORM_FUNCTION(math::Mat3, GLfloat, glGetUniformfv);
 	DECLARE_GET_UNIFORM_FUNCTION(math::Mat4, GLfloat, glGetUniformfv);
 
-#define DECLARE_SET_UNIFORM_FUNCTION(type, func, ...) \
+#define DECLARE_SET_UNIFORM_FUNCTION(type, func, programFunc, ...) \
 template<> \
 void ShaderProgram::SetUniform<type>(const std::string& p_name, const type& value) \
 { \
@@ -126,16 +134,31 @@ void ShaderProgram::SetUniform<type>(const std::string& p_name, const type& valu
 	{ \
 		func(it->second, __VA_ARGS__); \
 	} \
+} \
+template<> \
+void ShaderProgram::SetUniform<type>(uint32_t p_location, const type& value) \
+{ \
+	programFunc(m_id, p_location, __VA_ARGS__); \
 }
 
-	DECLARE_SET_UNIFORM_FUNCTION(int, glUniform1i, value);
-	DECLARE_SET_UNIFORM_FUNCTION(unsigned int, glUniform1ui, value);
-	DECLARE_SET_UNIFORM_FUNCTION(float, glUniform1f, value);
-	DECLARE_SET_UNIFORM_FUNCTION(math::Vec2, glUniform2f, value.x, value.y);
-	DECLARE_SET_UNIFORM_FUNCTION(math::Vec3, glUniform3f, value.x, value.y, value.z);
-	DECLARE_SET_UNIFORM_FUNCTION(math::Vec4, glUniform4f, value.x, value.y, value.z, value.w);
-	DECLARE_SET_UNIFORM_FUNCTION(math::Mat3, glUniformMatrix3fv, 1, GL_FALSE, &value[0][0]);
-	DECLARE_SET_UNIFORM_FUNCTION(math::Mat4, glUniformMatrix4fv, 1, GL_FALSE, &value[0][0]);
+	DECLARE_SET_UNIFORM_FUNCTION(int, glUniform1i, glProgramUniform1i, value);
+	DECLARE_SET_UNIFORM_FUNCTION(unsigned int, glUniform1ui, glProgramUniform1ui, value);
+	DECLARE_SET_UNIFORM_FUNCTION(float, glUniform1f, glProgramUniform1f, value);
+	DECLARE_SET_UNIFORM_FUNCTION(math::Vec2, glUniform2f, glProgramUniform2f, value.x, value.y);
+	DECLARE_SET_UNIFORM_FUNCTION(math::Vec3, glUniform3f, glProgramUniform3f, value.x, value.y, value.z);
+	DECLARE_SET_UNIFORM_FUNCTION(math::Vec4, glUniform4f, glProgramUniform4f, value.x, value.y, value.z, value.w);
+	DECLARE_SET_UNIFORM_FUNCTION(math::Mat3, glUniformMatrix3fv, glProgramUniformMatrix3fv, 1, GL_FALSE, &value[0][0]);
+	DECLARE_SET_UNIFORM_FUNCTION(math::Mat4, glUniformMatrix4fv, glProgramUniformMatrix4fv, 1, GL_FALSE, &value[0][0]);
+
+	std::optional<uint32_t> ShaderProgram::GetUniformLocation(const std::string& p_name) const
+	{
+		if (auto it = m_uniformsLocationCache.find(p_name); it != m_uniformsLocationCache.end())
+		{
+			return it->second;
+		}
+
+		return std::nullopt;
+	}
 
 	std::optional<std::reference_wrapper<const baregl::data::UniformInfo>> ShaderProgram::GetUniformInfo(const std::string& p_name) const
 	{
@@ -152,6 +175,31 @@ void ShaderProgram::SetUniform<type>(const std::string& p_name, const type& valu
 		return m_uniforms;
 	}
 
+	std::array<uint32_t, 3> ShaderProgram::GetComputeWorkGroupSize() const
+	{
+		std::array<GLint, 3> workGroupSize{};
+		glGetProgramiv(m_id, GL_COMPUTE_WORK_GROUP_SIZE, workGroupSize.data());
+
+		return {
+			static_cast<uint32_t>(workGroupSize[0]),
+			static_cast<uint32_t>(workGroupSize[1]),
+			static_cast<uint32_t>(workGroupSize[2])
+		};
+	}
+
+	std::array<uint32_t, 3> ShaderProgram::GetComputeWorkGroupCount(uint32_t p_x, uint32_t p_y, uint32_t p_z) const
+	{
+		const auto workGroupSize = GetComputeWorkGroupSize();
+
+		BAREGL_ASSERT(workGroupSize[0] > 0, "Program doesn't have a valid compute work group size");
+
+		return {
+			(p_x + workGroupSize[0] - 1) / workGroupSize[0],
+			(p_y + workGroupSize[1] - 1) / workGroupSize[1],
+			(p_z + workGroupSize[2] - 1) / workGroupSize[2]
+		};
+	}
+
 	void ShaderProgram::QueryUniforms()
 	{
 		m_uniforms.clear();
@@ -0,0 +1,197 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/SparseBuffer.h>
+
+#include <baregl/debug/Assert.h>
+#include <baregl/debug/Log.h>
+#include <baregl/detail/glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+	// Granularity of the fallback, each page being a separate buffer. Larger than common sparse page sizes
+	// to keep the number of buffer objects low.
+	constexpr uint64_t k_fallbackPageSize = 1024 * 1024;
+}
+
+namespace baregl
+{
+	SparseBuffer::SparseBuffer(uint64_t p_size, bool p_useExtension) :
+		m_sparse{ p_useExtension && GLAD_GL_ARB_sparse_buffer != 0 },
+		m_pageSize{ k_fallbackPageSize }
+	{
+		BAREGL_ASSERT(p_size > 0, "Sparse buffer cannot be empty");
+
+		if (m_sparse)
+		{
+			GLint pageSize = 0;
+			glGetIntegerv(GL_SPARSE_BUFFER_PAGE_SIZE_ARB, &pageSize);
+			m_pageSize = static_cast<uint64_t>(pageSize);
+		}
+		else if (p_useExtension)
+		{
+			BAREGL_LOG_WARNING("GL_ARB_sparse_buffer is not supported, falling back to one buffer per page");
+		}
+
+		const uint64_t pageCount = (p_size + m_pageSize - 1) / m_pageSize;
+		m_committedPages.resize(static_cast<size_t>(pageCount), false);
+
+		if (m_sparse)
+		{
+			m_buffer = std::make_unique<Buffer>();
+			m_buffer->Allocate(
+				pageCount * m_pageSize,
+				types::EBufferStorageFlags::SPARSE_STORAGE |
+				types::EBufferStorageFlags::DYNAMIC_STORAGE
+			);
+		}
+		else
+		{
+			m_pageBuffers.resize(static_cast<size_t>(pageCount));
+		}
+	}
+
+	void SparseBuffer::Commit(data::BufferMemoryRange p_range)
+	{
+		SetPagesCommitment(p_range, true);
+	}
+
+	void SparseBuffer::Decommit(data::BufferMemoryRange p_range)
+	{
+		SetPagesCommitment(p_range, false);
+	}
+
+	bool SparseBuffer::IsCommitted(data::BufferMemoryRange p_range) const
+	{
+		BAREGL_ASSERT(p_range.offset + p_range.size <= GetSize(), "Range exceeds the sparse buffer size");
+
+		const uint64_t firstPage = p_range.offset / m_pageSize;
+		const uint64_t lastPage = (p_range.offset + p_range.size + m_pageSize - 1) / m_pageSize;
+
+		for (uint64_t page = firstPage; page < lastPage; ++page)
+		{
+			if (!m_committedPages[page])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void SparseBuffer::Upload(const void* p_data, data::BufferMemoryRange p_range)
+	{
+		BAREGL_ASSERT(IsCommitted(p_range), "Cannot upload to pages that aren't committed");
+
+		if (m_sparse)
+		{
+			m_buffer->Upload(p_data, p_range);
+			return;
+		}
+
+		// Split the upload at page boundaries, each page being backed by its own buffer
+		const auto* data = static_cast<const std::byte*>(p_data);
+
+		for (uint64_t uploaded = 0; uploaded < p_range.size;)
+		{
+			const uint64_t offset = p_range.offset + uploaded;
+			const uint64_t pageOffset = offset % m_pageSize;
+			const uint64_t size = std::min(p_range.size - uploaded, m_pageSize - pageOffset);
+
+			m_pageBuffers[offset / m_pageSize]->Upload(data + uploaded, data::BufferMemoryRange{ .offset = pageOffset, .size = size });
+			uploaded += size;
+		}
+	}
+
+	data::BufferBinding SparseBuffer::Resolve(data::BufferMemoryRange p_range) const
+	{
+		BAREGL_ASSERT(IsCommitted(p_range), "Cannot resolve a range that isn't committed");
+
+		if (m_sparse)
+		{
+			return { *m_buffer, p_range };
+		}
+
+		const uint64_t page = p_range.offset / m_pageSize;
+		const uint64_t pageOffset = p_range.offset % m_pageSize;
+
+		BAREGL_ASSERT(pageOffset + p_range.size <= m_pageSize, "Range crosses a page boundary, which the fallback cannot resolve");
+
+		return { *m_pageBuffers[page], { .offset = pageOffset, .size = p_range.size } };
+	}
+
+	bool SparseBuffer::IsSparse() const
+	{
+		return m_sparse;
+	}
+
+	Buffer& SparseBuffer::GetBuffer()
+	{
+		BAREGL_ASSERT(m_sparse, "The fallback has no single underlying buffer, use Resolve instead");
+		return *m_buffer;
+	}
+
+	uint64_t SparseBuffer::GetPageSize() const
+	{
+		return m_pageSize;
+	}
+
+	uint64_t SparseBuffer::GetSize() const
+	{
+		return m_committedPages.size() * m_pageSize;
+	}
+
+	uint64_t SparseBuffer::GetCommittedBytes() const
+	{
+		return m_committedPageCount * m_pageSize;
+	}
+
+	void SparseBuffer::SetPagesCommitment(data::BufferMemoryRange p_range, bool p_commit)
+	{
+		BAREGL_ASSERT(p_range.size > 0, "Cannot change the commitment of an empty range");
+		BAREGL_ASSERT(p_range.offset + p_range.size <= GetSize(), "Range exceeds the sparse buffer size");
+
+		const uint64_t firstPage = p_range.offset / m_pageSize;
+		const uint64_t lastPage = (p_range.offset + p_range.size + m_pageSize - 1) / m_pageSize;
+
+		for (uint64_t page = firstPage; page < lastPage; ++page)
+		{
+			if (m_committedPages[page] == p_commit)
+			{
+				continue;
+			}
+
+			m_committedPages[page] = p_commit;
+			p_commit ? ++m_committedPageCount : --m_committedPageCount;
+
+			if (!m_sparse)
+			{
+				if (p_commit)
+				{
+					m_pageBuffers[page] = std::make_unique<Buffer>();
+					m_pageBuffers[page]->Allocate(m_pageSize, types::EBufferStorageFlags::DYNAMIC_STORAGE);
+				}
+				else
+				{
+					m_pageBuffers[page].reset();
+				}
+			}
+		}
+
+		if (m_sparse)
+		{
+			glNamedBufferPageCommitmentARB(
+				m_buffer->GetID(),
+				firstPage * m_pageSize,
+				(lastPage - firstPage) * m_pageSize,
+				p_commit ? GL_TRUE : GL_FALSE
+			);
+		}
+	}
+}
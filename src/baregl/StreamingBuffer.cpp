@@ -0,0 +1,103 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/StreamingBuffer.h>
+
+#include <baregl/debug/Assert.h>
+
+namespace
+{
+	baregl::BufferMapping AllocateAndMap(baregl::Buffer& p_buffer, uint64_t p_size)
+	{
+		using namespace baregl::types;
+
+		BAREGL_ASSERT(p_size > 0, "Streaming buffer cannot be empty");
+
+		// Immutable storage is required for persistent mapping
+		p_buffer.Allocate(
+			p_size,
+			EBufferStorageFlags::MAP_WRITE |
+			EBufferStorageFlags::MAP_PERSISTENT |
+			EBufferStorageFlags::MAP_COHERENT
+		);
+
+		return p_buffer.Map(
+			EBufferMapFlags::WRITE |
+			EBufferMapFlags::PERSISTENT |
+			EBufferMapFlags::COHERENT
+		);
+	}
+
+	constexpr uint64_t AlignUp(uint64_t p_value, uint64_t p_alignment)
+	{
+		return (p_value + p_alignment - 1) / p_alignment * p_alignment;
+	}
+}
+
+namespace baregl
+{
+	StreamingBuffer::StreamingBuffer(uint64_t p_regionSize, uint32_t p_regionCount) :
+		m_mapping{ AllocateAndMap(m_buffer, p_regionSize * p_regionCount) },
+		m_fences(p_regionCount),
+		m_regionSize{ p_regionSize }
+	{
+		BAREGL_ASSERT(p_regionCount > 0, "Streaming buffer requires at least one region");
+	}
+
+	std::optional<data::StreamingAllocation> StreamingBuffer::Allocate(uint64_t p_size, uint64_t p_alignment)
+	{
+		BAREGL_ASSERT(p_alignment > 0, "Alignment cannot be zero");
+
+		const uint64_t regionOffset = m_currentRegion * m_regionSize;
+
+		// Alignment is applied on the absolute offset, since this is what gets bound on the GPU side
+		const uint64_t offset = AlignUp(regionOffset + m_head, p_alignment);
+
+		if (offset + p_size > regionOffset + m_regionSize)
+		{
+			return std::nullopt;
+		}
+
+		m_head = offset + p_size - regionOffset;
+
+		return data::StreamingAllocation{
+			.data = m_mapping.GetData().subspan(static_cast<size_t>(offset), static_cast<size_t>(p_size)),
+			.offset = offset
+		};
+	}
+
+	void StreamingBuffer::NextFrame()
+	{
+		m_fences[m_currentRegion].Insert();
+
+		m_currentRegion = (m_currentRegion + 1) % GetRegionCount();
+		m_head = 0;
+
+		// The GPU might still be reading from the region we are about to overwrite
+		m_fences[m_currentRegion].Wait();
+		m_fences[m_currentRegion].Reset();
+	}
+
+	Buffer& StreamingBuffer::GetBuffer()
+	{
+		return m_buffer;
+	}
+
+	uint64_t StreamingBuffer::GetRegionSize() const
+	{
+		return m_regionSize;
+	}
+
+	uint32_t StreamingBuffer::GetRegionCount() const
+	{
+		return static_cast<uint32_t>(m_fences.size());
+	}
+
+	uint64_t StreamingBuffer::GetUsedBytes() const
+	{
+		return m_head;
+	}
+}
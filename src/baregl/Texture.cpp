@@ -10,6 +10,7 @@
 #include <baregl/debug/Event.h>
 #include <baregl/debug/Log.h>
 #include <baregl/detail/glad/glad.h>
+#include <baregl/detail/StateCache.h>
 #include <baregl/detail/Types.h>
 
 namespace
@@ -52,10 +53,15 @@ namespace baregl
 	{
 		if (p_slot.has_value())
 		{
-			glBindTextureUnit(p_slot.value(), m_id);
+			if (detail::GetStateCache().BindTextureUnit(p_slot.value(), m_id))
+			{
+				glBindTextureUnit(p_slot.value(), m_id);
+			}
 		}
 		else
 		{
+			// Binding to the active texture unit can't be tracked, since the active unit isn't shadowed
+			detail::GetStateCache().ForgetTextureUnits();
 			glBindTexture(m_type, m_id);
 		}
 	}
@@ -70,6 +76,7 @@ namespace baregl
 
 	void Texture::Unbind() const
 	{
+		detail::GetStateCache().ForgetTextureUnits();
 		glBindTexture(m_type, 0);
 	}
 
@@ -81,6 +88,7 @@ namespace baregl
 	Texture::~Texture()
 	{
 		glDeleteTextures(1, &m_id);
+		detail::GetStateCache().ForgetTexture(m_id);
 		NOTIFY_TEXTURE_DESTROYED;
 	}
 
@@ -0,0 +1,135 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/UploadBatcher.h>
+
+#include <baregl/debug/Assert.h>
+
+#include <cstring>
+
+namespace baregl
+{
+	UploadBatcher::UploadBatcher(uint64_t p_stagingSize, uint32_t p_frameCount) :
+		m_staging(p_stagingSize, p_frameCount)
+	{
+	}
+
+	bool UploadBatcher::Upload(Buffer& p_destination, const void* p_data, data::BufferMemoryRange p_range)
+	{
+		BAREGL_ASSERT(p_range.size > 0, "Cannot upload an empty range");
+		BAREGL_ASSERT(p_range.offset + p_range.size <= p_destination.GetSize(), "Uploaded range exceeds the buffer size");
+
+		const auto allocation = m_staging.Allocate(p_range.size);
+
+		if (!allocation.has_value())
+		{
+			return false;
+		}
+
+		std::memcpy(allocation->data.data(), p_data, static_cast<size_t>(p_range.size));
+
+		Overwrite(m_pending[&p_destination], p_range.offset, { p_range.size, allocation->offset });
+
+		++m_currentStatistics.uploadCount;
+		m_currentStatistics.uploadedBytes += p_range.size;
+
+		return true;
+	}
+
+	void UploadBatcher::Flush()
+	{
+		Buffer& staging = m_staging.GetBuffer();
+
+		for (auto& [destination, pieces] : m_pending)
+		{
+			auto it = pieces.begin();
+
+			while (it != pieces.end())
+			{
+				const uint64_t offset = it->first;
+				const uint64_t stagingOffset = it->second.stagingOffset;
+				uint64_t size = it->second.size;
+
+				// Extend the copy for as long as both the destination and the staging ranges are contiguous
+				for (++it; it != pieces.end(); ++it)
+				{
+					if (it->first != offset + size || it->second.stagingOffset != stagingOffset + size)
+					{
+						break;
+					}
+
+					size += it->second.size;
+				}
+
+				destination->CopyFrom(staging, stagingOffset, offset, size);
+
+				++m_currentStatistics.commandCount;
+				m_currentStatistics.copiedBytes += size;
+			}
+		}
+
+		m_pending.clear();
+	}
+
+	void UploadBatcher::NextFrame()
+	{
+		Flush();
+		m_staging.NextFrame();
+
+		m_lastStatistics = m_currentStatistics;
+
+		// Overwriting the middle of a pending upload splits it, which can issue more commands than uploads
+		m_lastStatistics.savedCommands = m_lastStatistics.commandCount >= m_lastStatistics.uploadCount ?
+			0 : m_lastStatistics.uploadCount - m_lastStatistics.commandCount;
+
+		m_lastStatistics.savedBytes = m_lastStatistics.uploadedBytes - m_lastStatistics.copiedBytes;
+		m_currentStatistics = {};
+	}
+
+	const data::UploadStatistics& UploadBatcher::GetStatistics() const
+	{
+		return m_lastStatistics;
+	}
+
+	void UploadBatcher::Overwrite(PieceMap& p_pieces, uint64_t p_offset, const Piece& p_piece)
+	{
+		const uint64_t end = p_offset + p_piece.size;
+
+		auto it = p_pieces.lower_bound(p_offset);
+
+		// A previous piece starting before the new one gets truncated, and split if it also ends after it
+		if (it != p_pieces.begin())
+		{
+			auto& [previousOffset, previous] = *std::prev(it);
+			const uint64_t previousEnd = previousOffset + previous.size;
+
+			if (previousEnd > p_offset)
+			{
+				previous.size = p_offset - previousOffset;
+
+				if (previousEnd > end)
+				{
+					p_pieces.emplace(end, Piece{ previousEnd - end, previous.stagingOffset + (end - previousOffset) });
+				}
+			}
+		}
+
+		// Pieces starting inside of the new one are dropped, keeping their tail if it goes past the new piece
+		while (it != p_pieces.end() && it->first < end)
+		{
+			const uint64_t pieceEnd = it->first + it->second.size;
+
+			if (pieceEnd > end)
+			{
+				p_pieces.emplace(end, Piece{ pieceEnd - end, it->second.stagingOffset + (end - it->first) });
+			}
+
+			it = p_pieces.erase(it);
+		}
+
+		p_pieces.emplace(p_offset, p_piece);
+	}
+}
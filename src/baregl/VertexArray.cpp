@@ -9,6 +9,7 @@
 #include <baregl/debug/Assert.h>
 #include <baregl/debug/Event.h>
 #include <baregl/detail/glad/glad.h>
+#include <baregl/detail/StateCache.h>
 #include <baregl/detail/Types.h>
 
 namespace
@@ -25,10 +26,19 @@ namespace
 		case baregl::types::EDataType::UNSIGNED_INT: return sizeof(GLuint);
 		case baregl::types::EDataType::FLOAT: return sizeof(GLfloat);
 		case baregl::types::EDataType::DOUBLE: return sizeof(GLdouble);
+		case baregl::types::EDataType::HALF_FLOAT: return sizeof(GLhalf);
 		default: return 0;
 		}
 	}
 
+	bool IsPackedDataType(baregl::types::EDataType p_type)
+	{
+		return
+			p_type == baregl::types::EDataType::INT_2_10_10_10_REV ||
+			p_type == baregl::types::EDataType::UNSIGNED_INT_2_10_10_10_REV ||
+			p_type == baregl::types::EDataType::UNSIGNED_INT_10F_11F_11F_REV;
+	}
+
 	uint32_t GetAttributeSizeInBytes(const baregl::data::VertexAttribute& p_attribute)
 	{
 		return std::visit([](const auto& attr) -> uint32_t {
@@ -37,6 +47,11 @@ namespace
 			{
 				return sizeof(GLdouble) * attr.count;
 			}
+			else if (IsPackedDataType(attr.type))
+			{
+				// Packed types hold every component in a single 32 bits word
+				return sizeof(GLuint);
+			}
 			else
 			{
 				return GetDataTypeSizeInBytes(attr.type) * attr.count;
@@ -44,34 +59,31 @@ namespace
 		}, p_attribute);
 	}
 
-	uint32_t CalculateTotalVertexSize(baregl::data::VertexAttributeLayout p_attributes)
-	{
-		uint32_t result = 0;
-
-		for (const auto& attribute : p_attributes)
-		{
-			result += GetAttributeSizeInBytes(attribute);
-		}
-
-		return result;
-	}
-
-	struct VertexAttribSetter
+	struct VertexAttribFormatSetter
 	{
+		GLuint vertexArray;
 		GLuint index;
-		GLsizei stride;
-		const GLvoid* offset;
+		GLuint relativeOffset;
 
 		void operator()(const baregl::data::FloatVertexAttribute& attr) const
 		{
 			BAREGL_ASSERT(attr.count >= 1 && attr.count <= 4, "Attribute count must be between 1 and 4");
-			glVertexAttribPointer(
+			BAREGL_ASSERT(
+				attr.count == 4 ||
+				(attr.type != baregl::types::EDataType::INT_2_10_10_10_REV && attr.type != baregl::types::EDataType::UNSIGNED_INT_2_10_10_10_REV),
+				"2_10_10_10_REV attributes must have 4 components"
+			);
+			BAREGL_ASSERT(
+				attr.count == 3 || attr.type != baregl::types::EDataType::UNSIGNED_INT_10F_11F_11F_REV,
+				"10F_11F_11F_REV attributes must have 3 components"
+			);
+			glVertexArrayAttribFormat(
+				vertexArray,
 				index,
 				static_cast<GLint>(attr.count),
 				baregl::utils::EnumToValue<GLenum>(attr.type),
 				static_cast<GLboolean>(attr.normalized),
-				stride,
-				offset
+				relativeOffset
 			);
 		}
 
@@ -85,26 +97,26 @@ namespace
 				attr.type == baregl::types::EDataType::UNSIGNED_SHORT ||
 				attr.type == baregl::types::EDataType::INT ||
 				attr.type == baregl::types::EDataType::UNSIGNED_INT,
-				"glVertexAttribIPointer requires an integer data type"
+				"glVertexArrayAttribIFormat requires an integer data type"
 			);
-			glVertexAttribIPointer(
+			glVertexArrayAttribIFormat(
+				vertexArray,
 				index,
 				static_cast<GLint>(attr.count),
 				baregl::utils::EnumToValue<GLenum>(attr.type),
-				stride,
-				offset
+				relativeOffset
 			);
 		}
 
 		void operator()(const baregl::data::DoubleVertexAttribute& attr) const
 		{
 			BAREGL_ASSERT(attr.count >= 1 && attr.count <= 4, "Attribute count must be between 1 and 4");
-			glVertexAttribLPointer(
+			glVertexArrayAttribLFormat(
+				vertexArray,
 				index,
 				static_cast<GLint>(attr.count),
 				GL_DOUBLE,
-				stride,
-				offset
+				relativeOffset
 			);
 		}
 	};
@@ -121,6 +133,7 @@ namespace baregl
 	VertexArray::~VertexArray()
 	{
 		glDeleteVertexArrays(1, &m_id);
+		detail::GetStateCache().ForgetVertexArray(m_id);
 		NOTIFY_VERTEX_ARRAY_DESTROYED;
 	}
 
@@ -135,57 +148,129 @@ namespace baregl
 		Buffer& p_indexBuffer
 	)
 	{
-		BAREGL_ASSERT(!IsValid(), "Vertex array layout already set");
+		SetLayout({ data::VertexBufferLayout{ .buffer = p_vertexBuffer, .attributes = p_attributes } }, p_indexBuffer);
+	}
 
-		Bind();
-		p_indexBuffer.Bind(types::EBufferType::INDEX);
-		p_vertexBuffer.Bind(types::EBufferType::VERTEX);
+	void VertexArray::SetLayout(
+		std::initializer_list<data::VertexBufferLayout> p_vertexBuffers,
+		std::optional<std::reference_wrapper<const Buffer>> p_indexBuffer
+	)
+	{
+		BAREGL_ASSERT(!IsValid(), "Vertex array layout already set");
 
-		uint32_t attributeIndex = 0;
+		for (const auto& vertexBuffer : p_vertexBuffers)
+		{
+			const uint32_t binding = SetupBinding(vertexBuffer.attributes, vertexBuffer.divisor);
 
-		const GLsizei totalSize = static_cast<GLsizei>(CalculateTotalVertexSize(p_attributes));
-		intptr_t currentOffset = 0;
+			SetVertexBuffer(
+				binding,
+				vertexBuffer.buffer.get(),
+				vertexBuffer.offset,
+				vertexBuffer.stride > 0 ? std::optional<uint32_t>{ vertexBuffer.stride } : std::nullopt
+			);
+		}
 
-		for (const auto& attribute : p_attributes)
+		if (p_indexBuffer.has_value())
 		{
-			glEnableVertexAttribArray(attributeIndex);
+			SetIndexBuffer(p_indexBuffer->get());
+		}
+	}
 
-			std::visit(VertexAttribSetter{
-				static_cast<GLuint>(attributeIndex),
-				totalSize,
-				reinterpret_cast<const GLvoid*>(currentOffset)
-			}, attribute);
+	void VertexArray::SetLayout(std::initializer_list<data::VertexBindingFormat> p_bindings)
+	{
+		BAREGL_ASSERT(!IsValid(), "Vertex array layout already set");
 
-			currentOffset += GetAttributeSizeInBytes(attribute);
-			++attributeIndex;
-			++m_attributeCount;
+		for (const auto& binding : p_bindings)
+		{
+			SetupBinding(binding.attributes, binding.divisor);
 		}
+	}
+
+	void VertexArray::SetVertexBuffer(uint32_t p_binding, const Buffer& p_buffer, uint64_t p_offset, std::optional<uint32_t> p_stride)
+	{
+		BAREGL_ASSERT(p_binding < m_bindingStrides.size(), "Vertex buffer binding not declared by the layout");
+
+		const uint32_t stride = p_stride.value_or(m_bindingStrides[p_binding]);
 
-		Unbind();
-		p_indexBuffer.Unbind();
-		p_vertexBuffer.Unbind();
+		BAREGL_ASSERT(stride >= m_bindingStrides[p_binding], "Vertex buffer attributes don't fit in the given stride");
+
+		glVertexArrayVertexBuffer(
+			m_id,
+			p_binding,
+			p_buffer.GetID(),
+			static_cast<GLintptr>(p_offset),
+			static_cast<GLsizei>(stride)
+		);
+	}
+
+	void VertexArray::SetIndexBuffer(const Buffer& p_buffer)
+	{
+		glVertexArrayElementBuffer(m_id, p_buffer.GetID());
 	}
 
 	void VertexArray::ResetLayout()
 	{
 		BAREGL_ASSERT(IsValid(), "Vertex array layout not already set");
 
-		Bind();
 		for (uint32_t i = 0; i < m_attributeCount; ++i)
 		{
-			glDisableVertexAttribArray(i);
+			glDisableVertexArrayAttrib(m_id, i);
 		}
+
+		// Divisors and buffers are binding state, they would otherwise leak into the next layout
+		for (uint32_t i = 0; i < m_bindingStrides.size(); ++i)
+		{
+			glVertexArrayBindingDivisor(m_id, i, 0);
+			glVertexArrayVertexBuffer(m_id, i, 0, 0, 0);
+		}
+
+		glVertexArrayElementBuffer(m_id, 0);
+
 		m_attributeCount = 0;
-		Unbind();
+		m_bindingStrides.clear();
 	}
 
 	void VertexArray::Bind() const
 	{
-		glBindVertexArray(m_id);
+		if (detail::GetStateCache().BindVertexArray(m_id))
+		{
+			glBindVertexArray(m_id);
+		}
 	}
 
 	void VertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		if (detail::GetStateCache().BindVertexArray(0))
+		{
+			glBindVertexArray(0);
+		}
+	}
+
+	uint32_t VertexArray::SetupBinding(data::VertexAttributeLayout p_attributes, uint32_t p_divisor)
+	{
+		const uint32_t binding = static_cast<uint32_t>(m_bindingStrides.size());
+
+		glVertexArrayBindingDivisor(m_id, binding, p_divisor);
+
+		uint32_t relativeOffset = 0;
+
+		for (const auto& attribute : p_attributes)
+		{
+			glEnableVertexArrayAttrib(m_id, m_attributeCount);
+			glVertexArrayAttribBinding(m_id, m_attributeCount, binding);
+
+			std::visit(VertexAttribFormatSetter{
+				m_id,
+				m_attributeCount,
+				relativeOffset
+			}, attribute);
+
+			relativeOffset += GetAttributeSizeInBytes(attribute);
+			++m_attributeCount;
+		}
+
+		m_bindingStrides.push_back(relativeOffset);
+
+		return binding;
 	}
 }
@@ -0,0 +1,104 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/VertexLayoutCache.h>
+
+#include <type_traits>
+#include <variant>
+
+namespace
+{
+	uint32_t EncodeAttribute(const baregl::data::VertexAttribute& p_attribute)
+	{
+		// One word per attribute: variant index, data type, component count and normalization
+		return std::visit([&p_attribute](const auto& attr) -> uint32_t {
+			using T = std::decay_t<decltype(attr)>;
+
+			uint32_t word = static_cast<uint32_t>(p_attribute.index()) << 24;
+			word |= static_cast<uint32_t>(attr.count) << 8;
+
+			if constexpr (!std::is_same_v<T, baregl::data::DoubleVertexAttribute>)
+			{
+				word |= static_cast<uint32_t>(attr.type) << 16;
+			}
+
+			if constexpr (std::is_same_v<T, baregl::data::FloatVertexAttribute>)
+			{
+				word |= static_cast<uint32_t>(attr.normalized);
+			}
+
+			return word;
+		}, p_attribute);
+	}
+
+	std::vector<uint32_t> EncodeFormat(std::initializer_list<baregl::data::VertexBindingFormat> p_bindings)
+	{
+		std::vector<uint32_t> key;
+
+		for (const auto& binding : p_bindings)
+		{
+			key.push_back(binding.divisor);
+			key.push_back(static_cast<uint32_t>(binding.attributes.size()));
+
+			for (const auto& attribute : binding.attributes)
+			{
+				key.push_back(EncodeAttribute(attribute));
+			}
+		}
+
+		return key;
+	}
+}
+
+namespace baregl
+{
+	size_t VertexLayoutCache::FormatKeyHash::operator()(const FormatKey& p_key) const
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		for (const uint32_t word : p_key)
+		{
+			hash = (hash ^ word) * 1099511628211ull;
+		}
+
+		return static_cast<size_t>(hash);
+	}
+
+	std::shared_ptr<VertexArray> VertexLayoutCache::Get(data::VertexAttributeLayout p_attributes)
+	{
+		return Get({ data::VertexBindingFormat{ .attributes = p_attributes } });
+	}
+
+	std::shared_ptr<VertexArray> VertexLayoutCache::Get(std::initializer_list<data::VertexBindingFormat> p_bindings)
+	{
+		auto [it, inserted] = m_vertexArrays.try_emplace(EncodeFormat(p_bindings));
+
+		if (inserted)
+		{
+			it->second = std::make_shared<VertexArray>();
+			it->second->SetLayout(p_bindings);
+		}
+
+		return it->second;
+	}
+
+	uint32_t VertexLayoutCache::Purge()
+	{
+		return static_cast<uint32_t>(std::erase_if(m_vertexArrays, [](const auto& p_entry) {
+			return p_entry.second.use_count() == 1;
+		}));
+	}
+
+	void VertexLayoutCache::Clear()
+	{
+		m_vertexArrays.clear();
+	}
+
+	uint32_t VertexLayoutCache::GetSize() const
+	{
+		return static_cast<uint32_t>(m_vertexArrays.size());
+	}
+}
@@ -0,0 +1,27 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/types/EBufferType.h>
+
+namespace baregl::detail
+{
+	/**
+	* Returns true if the given buffer type has indexed binding points (glBindBufferBase/glBindBufferRange)
+	* @param p_type
+	*/
+	constexpr bool IsIndexedBufferType(types::EBufferType p_type)
+	{
+		using enum types::EBufferType;
+
+		return
+			p_type == UNIFORM ||
+			p_type == SHADER_STORAGE ||
+			p_type == ATOMIC_COUNTER ||
+			p_type == TRANSFORM_FEEDBACK;
+	}
+}
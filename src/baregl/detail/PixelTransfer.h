@@ -0,0 +1,37 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/detail/glad/glad.h>
+#include <baregl/detail/Types.h>
+
+namespace baregl::detail
+{
+	/**
+	* Reads pixels from the framebuffer currently bound for reading
+	* @note If a pixel-pack buffer is bound, p_data is interpreted as an offset into that buffer
+	*/
+	inline void ReadPixels(
+		uint32_t p_x,
+		uint32_t p_y,
+		uint32_t p_width,
+		uint32_t p_height,
+		types::EPixelDataFormat p_format,
+		types::EPixelDataType p_type,
+		void* p_data
+	)
+	{
+		glReadPixels(
+			p_x, p_y,
+			p_width,
+			p_height,
+			utils::EnumToValue<GLenum>(p_format),
+			utils::EnumToValue<GLenum>(p_type),
+			p_data
+		);
+	}
+}
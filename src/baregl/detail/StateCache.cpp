@@ -0,0 +1,202 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/detail/StateCache.h>
+
+#include <algorithm>
+
+namespace baregl::detail
+{
+	template<typename T>
+	bool StateCache::Update(std::optional<T>& p_cached, const T& p_value, bool p_pipelineState)
+	{
+		if (p_cached == p_value)
+		{
+			++m_statistics.elidedCalls;
+			return false;
+		}
+
+		p_cached = p_value;
+		++m_statistics.submittedCalls;
+
+		if (p_pipelineState)
+		{
+			m_appliedPipelineState = 0;
+		}
+
+		return true;
+	}
+
+	bool StateCache::SetCapability(types::ERenderingCapability p_capability, bool p_value)
+	{
+		return Update(m_capabilities[static_cast<size_t>(p_capability)], p_value);
+	}
+
+	bool StateCache::SetDepthAlgorithm(types::EComparaisonAlgorithm p_algorithm)
+	{
+		return Update(m_depthAlgorithm, p_algorithm);
+	}
+
+	bool StateCache::SetBlendingFunction(types::EBlendingFactor p_sourceFactor, types::EBlendingFactor p_destinationFactor)
+	{
+		return Update(m_blendingFunction, std::make_pair(p_sourceFactor, p_destinationFactor));
+	}
+
+	bool StateCache::SetBlendingEquation(types::EBlendingEquation p_equation)
+	{
+		return Update(m_blendingEquation, p_equation);
+	}
+
+	bool StateCache::SetStencilAlgorithm(types::EComparaisonAlgorithm p_algorithm, int32_t p_reference, uint32_t p_mask)
+	{
+		return Update(m_stencilAlgorithm, std::make_tuple(p_algorithm, p_reference, p_mask));
+	}
+
+	bool StateCache::SetStencilMask(uint32_t p_mask)
+	{
+		return Update(m_stencilMask, p_mask);
+	}
+
+	bool StateCache::SetStencilOperations(types::EOperation p_stencilFail, types::EOperation p_depthFail, types::EOperation p_bothPass)
+	{
+		return Update(m_stencilOperations, std::make_tuple(p_stencilFail, p_depthFail, p_bothPass));
+	}
+
+	bool StateCache::SetRasterizationMode(types::ERasterizationMode p_rasterizationMode)
+	{
+		return Update(m_rasterizationMode, p_rasterizationMode);
+	}
+
+	bool StateCache::SetRasterizationLinesWidth(float p_width)
+	{
+		return Update(m_lineWidth, p_width);
+	}
+
+	bool StateCache::SetCullFace(types::ECullFace p_cullFace)
+	{
+		return Update(m_cullFace, p_cullFace);
+	}
+
+	bool StateCache::SetDepthWriting(bool p_enable)
+	{
+		return Update(m_depthWriting, p_enable);
+	}
+
+	bool StateCache::SetColorWriting(bool p_enableRed, bool p_enableGreen, bool p_enableBlue, bool p_enableAlpha)
+	{
+		const uint8_t mask =
+			(p_enableRed ? 0x1 : 0) |
+			(p_enableGreen ? 0x2 : 0) |
+			(p_enableBlue ? 0x4 : 0) |
+			(p_enableAlpha ? 0x8 : 0);
+
+		return Update(m_colorWriting, mask);
+	}
+
+	bool StateCache::SetViewport(uint32_t p_x, uint32_t p_y, uint32_t p_width, uint32_t p_height)
+	{
+		return Update(m_viewport, std::array<uint32_t, 4>{ p_x, p_y, p_width, p_height }, false);
+	}
+
+	bool StateCache::BindProgram(uint32_t p_id)
+	{
+		return Update(m_program, p_id, false);
+	}
+
+	bool StateCache::BindVertexArray(uint32_t p_id)
+	{
+		return Update(m_vertexArray, p_id, false);
+	}
+
+	bool StateCache::BindTextureUnit(uint32_t p_slot, uint32_t p_id)
+	{
+		if (p_slot >= m_textureUnits.size())
+		{
+			m_textureUnits.resize(p_slot + 1);
+		}
+
+		return Update(m_textureUnits[p_slot], p_id, false);
+	}
+
+	bool StateCache::IsPipelineStateApplied(uint32_t p_id) const
+	{
+		return p_id != 0 && m_appliedPipelineState == p_id;
+	}
+
+	void StateCache::SetAppliedPipelineState(uint32_t p_id)
+	{
+		m_appliedPipelineState = p_id;
+	}
+
+	void StateCache::ForgetTextureUnits()
+	{
+		std::ranges::fill(m_textureUnits, std::nullopt);
+	}
+
+	void StateCache::ForgetProgram(uint32_t p_id)
+	{
+		if (m_program == p_id)
+		{
+			m_program.reset();
+		}
+	}
+
+	void StateCache::ForgetVertexArray(uint32_t p_id)
+	{
+		if (m_vertexArray == p_id)
+		{
+			m_vertexArray.reset();
+		}
+	}
+
+	void StateCache::ForgetTexture(uint32_t p_id)
+	{
+		for (auto& unit : m_textureUnits)
+		{
+			if (unit == p_id)
+			{
+				unit.reset();
+			}
+		}
+	}
+
+	void StateCache::Invalidate()
+	{
+		std::ranges::fill(m_capabilities, std::nullopt);
+		m_depthAlgorithm.reset();
+		m_blendingFunction.reset();
+		m_blendingEquation.reset();
+		m_stencilAlgorithm.reset();
+		m_stencilMask.reset();
+		m_stencilOperations.reset();
+		m_rasterizationMode.reset();
+		m_lineWidth.reset();
+		m_cullFace.reset();
+		m_depthWriting.reset();
+		m_colorWriting.reset();
+		m_viewport.reset();
+		m_program.reset();
+		m_vertexArray.reset();
+		m_textureUnits.clear();
+		m_appliedPipelineState = 0;
+	}
+
+	const data::StateCacheStatistics& StateCache::GetStatistics() const
+	{
+		return m_statistics;
+	}
+
+	void StateCache::ResetStatistics()
+	{
+		m_statistics = {};
+	}
+
+	StateCache& GetStateCache()
+	{
+		static StateCache stateCache;
+		return stateCache;
+	}
+}
@@ -0,0 +1,117 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#pragma once
+
+#include <baregl/data/StateCacheStatistics.h>
+#include <baregl/types/EBlendingEquation.h>
+#include <baregl/types/EBlendingFactor.h>
+#include <baregl/types/EComparaisonAlgorithm.h>
+#include <baregl/types/ECullFace.h>
+#include <baregl/types/EOperation.h>
+#include <baregl/types/ERasterizationMode.h>
+#include <baregl/types/ERenderingCapability.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace baregl::detail
+{
+	/**
+	* Shadows the GL state set through BareGL, so that redundant calls can be skipped.
+	* Each setter returns true if the call must be forwarded to the driver.
+	* @note An unknown (std::nullopt) value never matches, so the next call always goes through
+	*/
+	class StateCache final
+	{
+	public:
+		bool SetCapability(types::ERenderingCapability p_capability, bool p_value);
+		bool SetDepthAlgorithm(types::EComparaisonAlgorithm p_algorithm);
+		bool SetBlendingFunction(types::EBlendingFactor p_sourceFactor, types::EBlendingFactor p_destinationFactor);
+		bool SetBlendingEquation(types::EBlendingEquation p_equation);
+		bool SetStencilAlgorithm(types::EComparaisonAlgorithm p_algorithm, int32_t p_reference, uint32_t p_mask);
+		bool SetStencilMask(uint32_t p_mask);
+		bool SetStencilOperations(types::EOperation p_stencilFail, types::EOperation p_depthFail, types::EOperation p_bothPass);
+		bool SetRasterizationMode(types::ERasterizationMode p_rasterizationMode);
+		bool SetRasterizationLinesWidth(float p_width);
+		bool SetCullFace(types::ECullFace p_cullFace);
+		bool SetDepthWriting(bool p_enable);
+		bool SetColorWriting(bool p_enableRed, bool p_enableGreen, bool p_enableBlue, bool p_enableAlpha);
+		bool SetViewport(uint32_t p_x, uint32_t p_y, uint32_t p_width, uint32_t p_height);
+		bool BindProgram(uint32_t p_id);
+		bool BindVertexArray(uint32_t p_id);
+		bool BindTextureUnit(uint32_t p_slot, uint32_t p_id);
+
+		/**
+		* Returns true if the given pipeline state is still in place, i.e. no cached state changed since it was applied
+		* @param p_id
+		*/
+		bool IsPipelineStateApplied(uint32_t p_id) const;
+
+		/**
+		* Records the given pipeline state as the one in place
+		* @param p_id
+		*/
+		void SetAppliedPipelineState(uint32_t p_id);
+
+		/**
+		* Forgets the textures bound to every unit (e.g. after a bind to the active texture unit)
+		*/
+		void ForgetTextureUnits();
+
+		/**
+		* Forgets a deleted object, so that a new object reusing its name isn't considered bound
+		* @param p_id
+		*/
+		void ForgetProgram(uint32_t p_id);
+		void ForgetVertexArray(uint32_t p_id);
+		void ForgetTexture(uint32_t p_id);
+
+		/**
+		* Marks the whole state as unknown
+		*/
+		void Invalidate();
+
+		const data::StateCacheStatistics& GetStatistics() const;
+		void ResetStatistics();
+
+	private:
+		// Fixed-function state changes invalidate the applied pipeline state, object bindings don't
+		template<typename T>
+		bool Update(std::optional<T>& p_cached, const T& p_value, bool p_pipelineState = true);
+
+	private:
+		static constexpr size_t k_capabilityCount = static_cast<size_t>(types::ERenderingCapability::LINE_SMOOTH) + 1;
+
+		std::array<std::optional<bool>, k_capabilityCount> m_capabilities;
+		std::optional<types::EComparaisonAlgorithm> m_depthAlgorithm;
+		std::optional<std::pair<types::EBlendingFactor, types::EBlendingFactor>> m_blendingFunction;
+		std::optional<types::EBlendingEquation> m_blendingEquation;
+		std::optional<std::tuple<types::EComparaisonAlgorithm, int32_t, uint32_t>> m_stencilAlgorithm;
+		std::optional<uint32_t> m_stencilMask;
+		std::optional<std::tuple<types::EOperation, types::EOperation, types::EOperation>> m_stencilOperations;
+		std::optional<types::ERasterizationMode> m_rasterizationMode;
+		std::optional<float> m_lineWidth;
+		std::optional<types::ECullFace> m_cullFace;
+		std::optional<bool> m_depthWriting;
+		std::optional<uint8_t> m_colorWriting;
+		std::optional<std::array<uint32_t, 4>> m_viewport;
+		std::optional<uint32_t> m_program;
+		std::optional<uint32_t> m_vertexArray;
+		std::vector<std::optional<uint32_t>> m_textureUnits;
+		uint32_t m_appliedPipelineState = 0;
+		data::StateCacheStatistics m_statistics;
+	};
+
+	/**
+	* Returns the state cache of the BareGL context
+	*/
+	StateCache& GetStateCache();
+}
@@ -10,6 +10,8 @@
 #include <baregl/types/EAccessSpecifier.h>
 #include <baregl/types/EBlendingEquation.h>
 #include <baregl/types/EBlendingFactor.h>
+#include <baregl/types/EBufferMapFlags.h>
+#include <baregl/types/EBufferStorageFlags.h>
 #include <baregl/types/EBufferType.h>
 #include <baregl/types/EComparaisonAlgorithm.h>
 #include <baregl/types/EContextFlags.h>
@@ -21,6 +23,7 @@
 #include <baregl/types/EGetParameter.h>
 #include <baregl/types/EHint.h>
 #include <baregl/types/EImageAccessSpecifier.h>
+#include <baregl/types/EIndexType.h>
 #include <baregl/types/EInternalFormat.h>
 #include <baregl/types/ELogicOperation.h>
 #include <baregl/types/EMemoryBarrierFlags.h>
@@ -250,6 +253,17 @@ struct baregl::utils::MappingFor<baregl::types::EPrimitiveMode, GLenum>
 	>;
 };
 
+template <>
+struct baregl::utils::MappingFor<baregl::types::EIndexType, GLenum>
+{
+	using EnumType = baregl::types::EIndexType;
+	using type = std::tuple<
+		EnumValuePair<EnumType::UNSIGNED_BYTE, GL_UNSIGNED_BYTE>,
+		EnumValuePair<EnumType::UNSIGNED_SHORT, GL_UNSIGNED_SHORT>,
+		EnumValuePair<EnumType::UNSIGNED_INT, GL_UNSIGNED_INT>
+	>;
+};
+
 template <>
 struct baregl::utils::MappingFor<baregl::types::EFormat, GLenum>
 {
@@ -357,7 +371,11 @@ struct baregl::utils::MappingFor<baregl::types::EDataType, GLenum>
 		EnumValuePair<EnumType::INT, GL_INT>,
 		EnumValuePair<EnumType::UNSIGNED_INT, GL_UNSIGNED_INT>,
 		EnumValuePair<EnumType::FLOAT, GL_FLOAT>,
-		EnumValuePair<EnumType::DOUBLE, GL_DOUBLE>
+		EnumValuePair<EnumType::DOUBLE, GL_DOUBLE>,
+		EnumValuePair<EnumType::HALF_FLOAT, GL_HALF_FLOAT>,
+		EnumValuePair<EnumType::INT_2_10_10_10_REV, GL_INT_2_10_10_10_REV>,
+		EnumValuePair<EnumType::UNSIGNED_INT_2_10_10_10_REV, GL_UNSIGNED_INT_2_10_10_10_REV>,
+		EnumValuePair<EnumType::UNSIGNED_INT_10F_11F_11F_REV, GL_UNSIGNED_INT_10F_11F_11F_REV>
 	>;
 };
 
@@ -544,7 +562,18 @@ struct baregl::utils::MappingFor<baregl::types::EBufferType, GLenum>
 		EnumValuePair<EnumType::VERTEX, GL_ARRAY_BUFFER>,
 		EnumValuePair<EnumType::INDEX, GL_ELEMENT_ARRAY_BUFFER>,
 		EnumValuePair<EnumType::UNIFORM, GL_UNIFORM_BUFFER>,
-		EnumValuePair<EnumType::SHADER_STORAGE, GL_SHADER_STORAGE_BUFFER>
+		EnumValuePair<EnumType::SHADER_STORAGE, GL_SHADER_STORAGE_BUFFER>,
+		EnumValuePair<EnumType::PIXEL_PACK, GL_PIXEL_PACK_BUFFER>,
+		EnumValuePair<EnumType::PIXEL_UNPACK, GL_PIXEL_UNPACK_BUFFER>,
+		EnumValuePair<EnumType::DRAW_INDIRECT, GL_DRAW_INDIRECT_BUFFER>,
+		EnumValuePair<EnumType::DISPATCH_INDIRECT, GL_DISPATCH_INDIRECT_BUFFER>,
+		EnumValuePair<EnumType::ATOMIC_COUNTER, GL_ATOMIC_COUNTER_BUFFER>,
+		EnumValuePair<EnumType::QUERY, GL_QUERY_BUFFER>,
+		EnumValuePair<EnumType::COPY_READ, GL_COPY_READ_BUFFER>,
+		EnumValuePair<EnumType::COPY_WRITE, GL_COPY_WRITE_BUFFER>,
+		EnumValuePair<EnumType::TEXTURE, GL_TEXTURE_BUFFER>,
+		EnumValuePair<EnumType::TRANSFORM_FEEDBACK, GL_TRANSFORM_FEEDBACK_BUFFER>,
+		EnumValuePair<EnumType::PARAMETER, GL_PARAMETER_BUFFER_ARB>
 	>;
 };
 
@@ -622,6 +651,37 @@ struct baregl::utils::MappingFor<baregl::types::EMemoryBarrierFlags, GLbitfield>
 	>;
 };
 
+template <>
+struct baregl::utils::MappingFor<baregl::types::EBufferStorageFlags, GLbitfield>
+{
+	using EnumType = baregl::types::EBufferStorageFlags;
+	using type = std::tuple<
+		EnumValuePair<EnumType::DYNAMIC_STORAGE, GL_DYNAMIC_STORAGE_BIT>,
+		EnumValuePair<EnumType::MAP_READ, GL_MAP_READ_BIT>,
+		EnumValuePair<EnumType::MAP_WRITE, GL_MAP_WRITE_BIT>,
+		EnumValuePair<EnumType::MAP_PERSISTENT, GL_MAP_PERSISTENT_BIT>,
+		EnumValuePair<EnumType::MAP_COHERENT, GL_MAP_COHERENT_BIT>,
+		EnumValuePair<EnumType::CLIENT_STORAGE, GL_CLIENT_STORAGE_BIT>,
+		EnumValuePair<EnumType::SPARSE_STORAGE, GL_SPARSE_STORAGE_BIT_ARB>
+	>;
+};
+
+template <>
+struct baregl::utils::MappingFor<baregl::types::EBufferMapFlags, GLbitfield>
+{
+	using EnumType = baregl::types::EBufferMapFlags;
+	using type = std::tuple<
+		EnumValuePair<EnumType::READ, GL_MAP_READ_BIT>,
+		EnumValuePair<EnumType::WRITE, GL_MAP_WRITE_BIT>,
+		EnumValuePair<EnumType::PERSISTENT, GL_MAP_PERSISTENT_BIT>,
+		EnumValuePair<EnumType::COHERENT, GL_MAP_COHERENT_BIT>,
+		EnumValuePair<EnumType::INVALIDATE_RANGE, GL_MAP_INVALIDATE_RANGE_BIT>,
+		EnumValuePair<EnumType::INVALIDATE_BUFFER, GL_MAP_INVALIDATE_BUFFER_BIT>,
+		EnumValuePair<EnumType::FLUSH_EXPLICIT, GL_MAP_FLUSH_EXPLICIT_BIT>,
+		EnumValuePair<EnumType::UNSYNCHRONIZED, GL_MAP_UNSYNCHRONIZED_BIT>
+	>;
+};
+
 template <>
 struct baregl::utils::MappingFor<baregl::types::EContextFlags, GLbitfield>
 {
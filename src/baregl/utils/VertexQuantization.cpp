@@ -0,0 +1,272 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <baregl/utils/VertexQuantization.h>
+
+#include <baregl/debug/Assert.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+// The widest instruction set enabled at compile time is used, the scalar code handles the remaining elements
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+#define BAREGL_QUANTIZATION_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BAREGL_QUANTIZATION_SSE2
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define BAREGL_QUANTIZATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+	static_assert(sizeof(baregl::math::Vec3) == 3 * sizeof(float));
+	static_assert(sizeof(baregl::math::Vec4) == 4 * sizeof(float));
+
+	constexpr uint32_t k_floatSignMask = 0x80000000;
+	constexpr uint32_t k_floatInfinity = 0x7F800000;
+
+	/**
+	* Converts the bits of a non-negative float to a float with a 5 bits exponent and the given mantissa width,
+	* rounding to nearest even (half floats use 10 bits, packed 11F and 10F floats use 6 and 5 bits)
+	*/
+	template<uint32_t MantissaBits>
+	uint32_t EncodeSmallFloat(uint32_t p_bits)
+	{
+		constexpr uint32_t shift = 23 - MantissaBits;
+		constexpr uint32_t infinity = 0x1Fu << MantissaBits;
+
+		// Too large for the 5 bits exponent (or infinity/NaN)
+		if (p_bits >= (127u + 16u) << 23)
+		{
+			return p_bits > k_floatInfinity ? infinity | (1u << (MantissaBits - 1)) : infinity;
+		}
+
+		// Subnormal result, the FPU does the rounding when adding the magic number
+		if (p_bits < (127u - 14u) << 23)
+		{
+			constexpr uint32_t magic = ((127u - 15u) + shift + 1u) << 23;
+			return std::bit_cast<uint32_t>(std::bit_cast<float>(p_bits) + std::bit_cast<float>(magic)) - magic;
+		}
+
+		// Normal result, rebias the exponent and round the mantissa (ties go to the even mantissa)
+		const uint32_t mantissaOdd = (p_bits >> shift) & 1;
+		return (p_bits - ((127u - 15u) << 23) + ((1u << (shift - 1)) - 1) + mantissaOdd) >> shift;
+	}
+
+	uint16_t EncodeHalfFloat(float p_value)
+	{
+		const uint32_t bits = std::bit_cast<uint32_t>(p_value);
+		const uint32_t sign = bits & k_floatSignMask;
+		return static_cast<uint16_t>((sign >> 16) | EncodeSmallFloat<10>(bits ^ sign));
+	}
+
+	template<uint32_t MantissaBits>
+	uint32_t EncodeUnsignedSmallFloat(float p_value)
+	{
+		// Unsigned floats can't store negative values, NaN must still be detected before clamping
+		const uint32_t bits = std::bit_cast<uint32_t>(p_value);
+		return (bits & k_floatSignMask) && !std::isnan(p_value) ? 0 : EncodeSmallFloat<MantissaBits>(bits & ~k_floatSignMask);
+	}
+
+	uint32_t EncodeNormalized(float p_value, float p_min, float p_scale, uint32_t p_mask)
+	{
+		// NaN maps to the minimum, like the max instructions used by the SIMD paths
+		const float clamped = std::isnan(p_value) ? p_min : std::clamp(p_value, p_min, 1.0f);
+		return static_cast<uint32_t>(std::lrint(clamped * p_scale)) & p_mask;
+	}
+
+	uint32_t Pack2_10_10_10(const baregl::math::Vec4& p_value, float p_min, float p_scale, float p_alphaScale)
+	{
+		return
+			EncodeNormalized(p_value.x, p_min, p_scale, 0x3FF) |
+			EncodeNormalized(p_value.y, p_min, p_scale, 0x3FF) << 10 |
+			EncodeNormalized(p_value.z, p_min, p_scale, 0x3FF) << 20 |
+			EncodeNormalized(p_value.w, p_min, p_alphaScale, 0x3) << 30;
+	}
+
+#if defined(BAREGL_QUANTIZATION_SSE2)
+	// Branchless version of EncodeHalfFloat, the result of each lane is sign extended so that it can be packed to 16 bits
+	__m128i EncodeHalfFloatSSE2(__m128 p_values)
+	{
+		const __m128i infinity = _mm_set1_epi32(0x7C00);
+		const __m128i nanBit = _mm_set1_epi32(0x200);
+		const __m128i maxValue = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + 13 + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+		const __m128 sign = _mm_and_ps(p_values, _mm_set1_ps(-0.0f));
+		const __m128 absolute = _mm_xor_ps(p_values, sign);
+		const __m128i absoluteBits = _mm_castps_si128(absolute);
+
+		const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		const __m128i isRegular = _mm_cmpgt_epi32(maxValue, absoluteBits);
+		const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absoluteBits);
+		const __m128i special = _mm_or_si128(_mm_and_si128(isNaN, nanBit), infinity);
+
+		const __m128 subnormalSum = _mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic));
+		const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormalSum), subnormalMagic);
+
+		const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+		const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd), 13);
+
+		const __m128i regular = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		const __m128i result = _mm_or_si128(_mm_and_si128(isRegular, regular), _mm_andnot_si128(isRegular, special));
+
+		return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+	}
+
+	// Quantizes 4 vectors at once: transposing them puts each component in its own register, so lanes can be shifted uniformly
+	__m128i Pack2_10_10_10SSE2(const float* p_source, __m128 p_min, __m128 p_scale, __m128 p_alphaScale)
+	{
+		__m128 x = _mm_loadu_ps(p_source);
+		__m128 y = _mm_loadu_ps(p_source + 4);
+		__m128 z = _mm_loadu_ps(p_source + 8);
+		__m128 w = _mm_loadu_ps(p_source + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128i mask = _mm_set1_epi32(0x3FF);
+
+		// _mm_max_ps returns its second operand when either is NaN, so NaN maps to the minimum
+		const __m128i qx = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, p_min), one), p_scale)), mask);
+		const __m128i qy = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(y, p_min), one), p_scale)), mask);
+		const __m128i qz = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(z, p_min), one), p_scale)), mask);
+		const __m128i qw = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(w, p_min), one), p_alphaScale));
+
+		return _mm_or_si128(
+			_mm_or_si128(qx, _mm_slli_epi32(qy, 10)),
+			_mm_or_si128(_mm_slli_epi32(qz, 20), _mm_slli_epi32(qw, 30))
+		);
+	}
+#elif defined(BAREGL_QUANTIZATION_NEON)
+	// Quantizes 4 vectors at once, the de-interleaving load puts each component in its own register
+	uint32x4_t Pack2_10_10_10NEON(const float* p_source, float32x4_t p_min, float32x4_t p_scale, float32x4_t p_alphaScale)
+	{
+		const float32x4x4_t values = vld4q_f32(p_source);
+
+		// vmaxnmq (unlike vmaxq) returns the number when the other operand is NaN, so NaN maps to the minimum
+
+		const float32x4_t one = vdupq_n_f32(1.0f);
+		const uint32x4_t mask = vdupq_n_u32(0x3FF);
+
+		const uint32x4_t qx = vandq_u32(vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_f32(vminq_f32(vmaxnmq_f32(values.val[0], p_min), one), p_scale))), mask);
+		const uint32x4_t qy = vandq_u32(vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_f32(vminq_f32(vmaxnmq_f32(values.val[1], p_min), one), p_scale))), mask);
+		const uint32x4_t qz = vandq_u32(vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_f32(vminq_f32(vmaxnmq_f32(values.val[2], p_min), one), p_scale))), mask);
+		const uint32x4_t qw = vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_f32(vminq_f32(vmaxnmq_f32(values.val[3], p_min), one), p_alphaScale)));
+
+		return vorrq_u32(
+			vorrq_u32(qx, vshlq_n_u32(qy, 10)),
+			vorrq_u32(vshlq_n_u32(qz, 20), vshlq_n_u32(qw, 30))
+		);
+	}
+#endif
+
+	void Quantize2_10_10_10(
+		std::span<const baregl::math::Vec4> p_source,
+		std::span<uint32_t> p_destination,
+		float p_min,
+		float p_scale,
+		float p_alphaScale
+	)
+	{
+		BAREGL_ASSERT(p_destination.size() >= p_source.size(), "Destination is too small");
+
+		const float* source = reinterpret_cast<const float*>(p_source.data());
+		size_t i = 0;
+
+#if defined(BAREGL_QUANTIZATION_SSE2)
+		const __m128 min = _mm_set1_ps(p_min);
+		const __m128 scale = _mm_set1_ps(p_scale);
+		const __m128 alphaScale = _mm_set1_ps(p_alphaScale);
+
+		for (; i + 4 <= p_source.size(); i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_destination.data() + i), Pack2_10_10_10SSE2(source + i * 4, min, scale, alphaScale));
+		}
+#elif defined(BAREGL_QUANTIZATION_NEON)
+		const float32x4_t min = vdupq_n_f32(p_min);
+		const float32x4_t scale = vdupq_n_f32(p_scale);
+		const float32x4_t alphaScale = vdupq_n_f32(p_alphaScale);
+
+		for (; i + 4 <= p_source.size(); i += 4)
+		{
+			vst1q_u32(p_destination.data() + i, Pack2_10_10_10NEON(source + i * 4, min, scale, alphaScale));
+		}
+#endif
+
+		for (; i < p_source.size(); ++i)
+		{
+			p_destination[i] = Pack2_10_10_10(p_source[i], p_min, p_scale, p_alphaScale);
+		}
+	}
+}
+
+namespace baregl::utils
+{
+	void QuantizeToHalfFloat(std::span<const float> p_source, std::span<uint16_t> p_destination)
+	{
+		BAREGL_ASSERT(p_destination.size() >= p_source.size(), "Destination is too small");
+
+		size_t i = 0;
+
+#if defined(BAREGL_QUANTIZATION_AVX2)
+		for (; i + 8 <= p_source.size(); i += 8)
+		{
+			const __m128i result = _mm256_cvtps_ph(_mm256_loadu_ps(p_source.data() + i), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_destination.data() + i), result);
+		}
+#elif defined(BAREGL_QUANTIZATION_SSE2)
+		for (; i + 8 <= p_source.size(); i += 8)
+		{
+			const __m128i low = EncodeHalfFloatSSE2(_mm_loadu_ps(p_source.data() + i));
+			const __m128i high = EncodeHalfFloatSSE2(_mm_loadu_ps(p_source.data() + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_destination.data() + i), _mm_packs_epi32(low, high));
+		}
+#elif defined(BAREGL_QUANTIZATION_NEON)
+		for (; i + 4 <= p_source.size(); i += 4)
+		{
+			const float16x4_t result = vcvt_f16_f32(vld1q_f32(p_source.data() + i));
+			vst1_u16(p_destination.data() + i, vreinterpret_u16_f16(result));
+		}
+#endif
+
+		for (; i < p_source.size(); ++i)
+		{
+			p_destination[i] = EncodeHalfFloat(p_source[i]);
+		}
+	}
+
+	void QuantizeToInt2_10_10_10Rev(std::span<const math::Vec4> p_source, std::span<uint32_t> p_destination)
+	{
+		Quantize2_10_10_10(p_source, p_destination, -1.0f, 511.0f, 1.0f);
+	}
+
+	void QuantizeToUnsignedInt2_10_10_10Rev(std::span<const math::Vec4> p_source, std::span<uint32_t> p_destination)
+	{
+		Quantize2_10_10_10(p_source, p_destination, 0.0f, 1023.0f, 3.0f);
+	}
+
+	void QuantizeToUnsignedInt10F_11F_11F_Rev(std::span<const math::Vec3> p_source, std::span<uint32_t> p_destination)
+	{
+		BAREGL_ASSERT(p_destination.size() >= p_source.size(), "Destination is too small");
+
+		for (size_t i = 0; i < p_source.size(); ++i)
+		{
+			p_destination[i] =
+				EncodeUnsignedSmallFloat<6>(p_source[i].x) |
+				EncodeUnsignedSmallFloat<6>(p_source[i].y) << 11 |
+				EncodeUnsignedSmallFloat<5>(p_source[i].z) << 22;
+		}
+	}
+}
@@ -0,0 +1,345 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <common/Boilerplate.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace tests::common::boilerplate;
+using namespace baregl;
+using namespace baregl::types;
+
+TEST_CASE( "Buffer::Download returns the uploaded data", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		const auto uploaded = std::to_array<uint32_t>({ 1, 2, 3, 4 });
+		std::array<uint32_t, 4> downloaded{};
+
+		Buffer buffer;
+		buffer.Allocate(sizeof(uploaded));
+		buffer.Upload(uploaded.data());
+		buffer.Download(downloaded.data());
+		REQUIRE( downloaded == uploaded );
+
+		uint32_t value = 0;
+		buffer.Download(&value, data::BufferMemoryRange{ .offset = 2 * sizeof(uint32_t), .size = sizeof(uint32_t) });
+		REQUIRE( value == 3 );
+	});
+}
+
+TEST_CASE( "BufferDownload returns the buffer content once ready", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		const auto uploaded = std::to_array<uint32_t>({ 1, 2, 3, 4 });
+
+		Buffer buffer;
+		buffer.Allocate(sizeof(uploaded));
+		buffer.Upload(uploaded.data());
+
+		BufferDownload download(sizeof(uploaded));
+		download.Request(buffer, data::BufferMemoryRange{ .offset = sizeof(uint32_t), .size = 2 * sizeof(uint32_t) });
+		REQUIRE( download.GetSize() == 2 * sizeof(uint32_t) );
+		REQUIRE( download.Wait() );
+		REQUIRE( download.IsReady() );
+
+		{
+			const auto mapping = download.GetData();
+			const auto data = mapping.GetData<const uint32_t>();
+			REQUIRE( data.size() == 2 );
+			REQUIRE( data[0] == 2 );
+			REQUIRE( data[1] == 3 );
+		}
+
+		// The staging buffer is reused once the previous mapping is released
+		download.Request(buffer);
+		REQUIRE( download.GetSize() == sizeof(uploaded) );
+		REQUIRE( download.GetCapacity() == sizeof(uploaded) );
+
+		const auto mapping = download.GetData();
+		const auto data = mapping.GetData<const uint32_t>();
+		REQUIRE( data.size() == uploaded.size() );
+		REQUIRE( data[3] == 4 );
+	});
+}
+
+#define GET(getParam, ...) p_context.Get<getParam>(__VA_ARGS__)
+
+TEST_CASE( "Buffer ranges can be bound to indexed binding points", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		using enum baregl::types::EGetParameter;
+
+		const auto alignment = static_cast<uint64_t>(GET(UNIFORM_BUFFER_OFFSET_ALIGNMENT));
+
+		Buffer ubo;
+		ubo.Allocate(alignment * 4);
+
+		ubo.Bind(EBufferType::UNIFORM, 1, data::BufferMemoryRange{ .offset = alignment, .size = alignment });
+		REQUIRE( GET(UNIFORM_BUFFER_BINDING, 1) == ubo.GetID() );
+		REQUIRE( GET(UNIFORM_BUFFER_START, 1) == static_cast<int64_t>(alignment) );
+		REQUIRE( GET(UNIFORM_BUFFER_SIZE, 1) == static_cast<int64_t>(alignment) );
+		ubo.Unbind();
+		REQUIRE( GET(UNIFORM_BUFFER_BINDING, 1) == 0 );
+
+		const auto bindings = std::to_array<data::BufferBinding>({
+			{ ubo, { .offset = 0, .size = alignment } },
+			{ ubo, { .offset = alignment * 2, .size = alignment * 2 } }
+		});
+
+		p_context.BindBuffersRange(EBufferType::UNIFORM, 2, bindings);
+		REQUIRE( GET(UNIFORM_BUFFER_BINDING, 2) == ubo.GetID() );
+		REQUIRE( GET(UNIFORM_BUFFER_BINDING, 3) == ubo.GetID() );
+		REQUIRE( GET(UNIFORM_BUFFER_START, 3) == static_cast<int64_t>(alignment * 2) );
+		REQUIRE( GET(UNIFORM_BUFFER_SIZE, 3) == static_cast<int64_t>(alignment * 2) );
+	});
+}
+
+#define REQUIRE_BINDS_TO(bufferType, getParam) \
+	buffer.Bind(bufferType); \
+	REQUIRE( GET(getParam) == buffer.GetID() ); \
+	buffer.Unbind(); \
+	REQUIRE( GET(getParam) == 0 )
+
+TEST_CASE( "Buffer can be bound to every buffer type", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		using enum baregl::types::EGetParameter;
+
+		Buffer buffer;
+		buffer.Allocate(64);
+
+		REQUIRE_BINDS_TO(EBufferType::VERTEX, ARRAY_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::UNIFORM, UNIFORM_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::SHADER_STORAGE, SHADER_STORAGE_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::PIXEL_PACK, PIXEL_PACK_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::PIXEL_UNPACK, PIXEL_UNPACK_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::DRAW_INDIRECT, DRAW_INDIRECT_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::DISPATCH_INDIRECT, DISPATCH_INDIRECT_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::ATOMIC_COUNTER, ATOMIC_COUNTER_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::QUERY, QUERY_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::COPY_READ, COPY_READ_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::COPY_WRITE, COPY_WRITE_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::TEXTURE, TEXTURE_BUFFER_BINDING);
+		REQUIRE_BINDS_TO(EBufferType::TRANSFORM_FEEDBACK, TRANSFORM_FEEDBACK_BUFFER_BINDING);
+
+		buffer.Bind(EBufferType::ATOMIC_COUNTER, 0);
+		REQUIRE( GET(ATOMIC_COUNTER_BUFFER_BINDING, 0) == buffer.GetID() );
+		buffer.Unbind();
+		REQUIRE( GET(ATOMIC_COUNTER_BUFFER_BINDING, 0) == 0 );
+	});
+}
+
+TEST_CASE( "BufferHeap allocates best fit blocks and merges them on release", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		BufferHeap heap(1024);
+
+		const auto a = heap.Allocate(100);
+		const auto b = heap.Allocate(200, 64);
+		const auto c = heap.Allocate(16);
+		REQUIRE( a.has_value() );
+		REQUIRE( b.has_value() );
+		REQUIRE( c.has_value() );
+		REQUIRE( a->offset == 0 );
+		REQUIRE( b->offset == 128 );
+		REQUIRE( c->offset == 100 ); // Best fit: the alignment padding before b
+		REQUIRE( heap.GetAllocationCount() == 3 );
+		REQUIRE( heap.GetUsedBytes() == 316 );
+		REQUIRE( heap.GetLargestFreeBlock() == 696 );
+		REQUIRE( !heap.Allocate(1000).has_value() );
+
+		heap.Free(*b);
+		REQUIRE( heap.GetLargestFreeBlock() == 908 );
+
+		heap.Free(*c);
+		REQUIRE( heap.GetLargestFreeBlock() == 924 );
+
+		heap.Free(*a);
+		REQUIRE( heap.GetAllocationCount() == 0 );
+		REQUIRE( heap.GetFreeBytes() == 1024 );
+		REQUIRE( heap.GetLargestFreeBlock() == 1024 );
+	});
+}
+
+TEST_CASE( "BufferHeap::Compact relocates allocations within its budget", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		BufferHeap heap(4096);
+
+		std::vector<uint32_t> content(256);
+		for (uint32_t i = 0; i < content.size(); ++i) content[i] = i;
+
+		std::vector<std::pair<uint64_t, uint64_t>> relocations;
+		const auto onRelocated = [&relocations](const data::BufferMemoryRange& p_from, const data::BufferMemoryRange& p_to) {
+			relocations.emplace_back(p_from.offset, p_to.offset);
+		};
+
+		const auto hole = heap.Allocate(16);
+		const auto first = heap.Allocate(content.size() * sizeof(uint32_t), 1, onRelocated);
+		const auto second = heap.Allocate(512, 1, onRelocated);
+		heap.GetBuffer().Upload(content.data(), *first);
+		heap.Free(*hole);
+
+		// The first allocation only travels 16 bytes, overlapping its previous range
+		REQUIRE( heap.Compact(1) == first->size );
+		REQUIRE( relocations.size() == 1 );
+		REQUIRE( relocations[0] == std::pair<uint64_t, uint64_t>{ 16, 0 } );
+
+		std::vector<uint32_t> downloaded(content.size());
+		heap.GetBuffer().Download(downloaded.data(), data::BufferMemoryRange{ .offset = 0, .size = first->size });
+		REQUIRE( downloaded == content );
+
+		REQUIRE( heap.Compact(1) == second->size );
+		REQUIRE( relocations.size() == 2 );
+		REQUIRE( relocations[1] == std::pair<uint64_t, uint64_t>{ first->offset + first->size, first->size } );
+
+		REQUIRE( heap.Compact(1) == 0 );
+		REQUIRE( heap.GetLargestFreeBlock() == heap.GetFreeBytes() );
+	});
+}
+
+TEST_CASE( "UploadBatcher merges adjacent uploads into a single copy", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		const auto uploaded = std::to_array<uint32_t>({ 1, 2, 3, 4 });
+
+		Buffer buffer;
+		buffer.Allocate(sizeof(uploaded));
+
+		UploadBatcher batcher(1024, 1);
+
+		for (uint32_t i = 0; i < uploaded.size(); ++i)
+		{
+			REQUIRE( batcher.Upload(buffer, &uploaded[i], { .offset = i * sizeof(uint32_t), .size = sizeof(uint32_t) }) );
+		}
+
+		batcher.NextFrame();
+
+		const auto& statistics = batcher.GetStatistics();
+		REQUIRE( statistics.uploadCount == 4 );
+		REQUIRE( statistics.commandCount == 1 );
+		REQUIRE( statistics.savedCommands == 3 );
+		REQUIRE( statistics.copiedBytes == sizeof(uploaded) );
+		REQUIRE( statistics.savedBytes == 0 );
+
+		std::array<uint32_t, 4> downloaded{};
+		buffer.Download(downloaded.data());
+		REQUIRE( downloaded == uploaded );
+	});
+}
+
+TEST_CASE( "UploadBatcher keeps the latest data when uploads overlap", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		const std::vector<uint8_t> first(100, 1);
+		const std::vector<uint8_t> second(20, 2);
+
+		Buffer buffer;
+		buffer.Allocate(first.size());
+
+		UploadBatcher batcher(1024, 1);
+
+		// The second upload lands in the middle of the first one, splitting it in two copies
+		REQUIRE( batcher.Upload(buffer, first.data(), { .offset = 0, .size = first.size() }) );
+		REQUIRE( batcher.Upload(buffer, second.data(), { .offset = 40, .size = second.size() }) );
+		batcher.NextFrame();
+
+		const auto& statistics = batcher.GetStatistics();
+		REQUIRE( statistics.uploadCount == 2 );
+		REQUIRE( statistics.commandCount == 3 );
+		REQUIRE( statistics.savedCommands == 0 );
+		REQUIRE( statistics.uploadedBytes == 120 );
+		REQUIRE( statistics.copiedBytes == 100 );
+		REQUIRE( statistics.savedBytes == 20 );
+
+		std::vector<uint8_t> downloaded(first.size());
+		buffer.Download(downloaded.data());
+
+		for (size_t i = 0; i < downloaded.size(); ++i)
+		{
+			REQUIRE( downloaded[i] == (i >= 40 && i < 60 ? 2 : 1) );
+		}
+
+		// Uploading the same range twice only copies the latest data
+		REQUIRE( batcher.Upload(buffer, second.data(), { .offset = 0, .size = second.size() }) );
+		REQUIRE( batcher.Upload(buffer, first.data(), { .offset = 0, .size = second.size() }) );
+		batcher.NextFrame();
+
+		REQUIRE( statistics.commandCount == 1 );
+		REQUIRE( statistics.savedCommands == 1 );
+		REQUIRE( statistics.savedBytes == 20 );
+
+		buffer.Download(downloaded.data());
+		REQUIRE( downloaded[0] == 1 );
+	});
+}
+
+TEST_CASE( "SparseBuffer commits and decommits pages", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		// Without GL_ARB_sparse_buffer, both iterations exercise the fallback
+		for (const bool useExtension : { true, false })
+		{
+			SparseBuffer buffer(64 * 1024 * 1024, useExtension);
+			const uint64_t page = buffer.GetPageSize();
+
+			REQUIRE( (useExtension || !buffer.IsSparse()) );
+			REQUIRE( buffer.GetCommittedBytes() == 0 );
+			REQUIRE( !buffer.IsCommitted({ .offset = 0, .size = 1 }) );
+
+			buffer.Commit({ .offset = page, .size = 2 * page });
+			REQUIRE( buffer.GetCommittedBytes() == 2 * page );
+			REQUIRE( buffer.IsCommitted({ .offset = page, .size = 2 * page }) );
+			REQUIRE( !buffer.IsCommitted({ .offset = 0, .size = 2 * page }) );
+
+			// Data crossing a page boundary can be uploaded at once, and read back page by page
+			const auto uploaded = std::to_array<uint32_t>({ 1, 2, 3, 4 });
+			buffer.Upload(uploaded.data(), { .offset = 2 * page - 8, .size = sizeof(uploaded) });
+
+			std::array<uint32_t, 2> downloaded{};
+			const auto first = buffer.Resolve({ .offset = 2 * page - 8, .size = 8 });
+			first.buffer.get().Download(downloaded.data(), first.range);
+			REQUIRE( downloaded == std::array<uint32_t, 2>{ 1, 2 } );
+
+			const auto second = buffer.Resolve({ .offset = 2 * page, .size = 8 });
+			second.buffer.get().Download(downloaded.data(), second.range);
+			REQUIRE( downloaded == std::array<uint32_t, 2>{ 3, 4 } );
+
+			buffer.Decommit({ .offset = page, .size = page });
+			REQUIRE( buffer.GetCommittedBytes() == page );
+			REQUIRE( !buffer.IsCommitted({ .offset = page, .size = 1 }) );
+			REQUIRE( buffer.IsCommitted({ .offset = 2 * page, .size = page }) );
+
+			// Decommitting a page leaves the other pages where they are, with their content
+			const auto remaining = buffer.Resolve({ .offset = 2 * page, .size = 8 });
+			REQUIRE( remaining.buffer.get().GetID() == second.buffer.get().GetID() );
+			remaining.buffer.get().Download(downloaded.data(), remaining.range);
+			REQUIRE( downloaded == std::array<uint32_t, 2>{ 3, 4 } );
+
+			buffer.Decommit({ .offset = 2 * page, .size = page });
+			REQUIRE( buffer.GetCommittedBytes() == 0 );
+		}
+	});
+}
+
+TEST_CASE( "BufferMapping is released when its buffer is destroyed first", "[buffer]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		std::optional<BufferMapping> mapping;
+
+		{
+			Buffer buffer;
+			buffer.Allocate(64, EBufferStorageFlags::MAP_WRITE);
+			mapping = buffer.Map(EBufferMapFlags::WRITE);
+			REQUIRE( mapping->IsMapped() );
+		}
+
+		REQUIRE( !mapping->IsMapped() );
+		REQUIRE( mapping->GetData().empty() );
+
+		// The mapping must not unmap a buffer that reused the name of the destroyed one
+		Buffer other;
+		other.Allocate(64, EBufferStorageFlags::MAP_WRITE);
+		auto otherMapping = other.Map(EBufferMapFlags::WRITE);
+		mapping.reset();
+		REQUIRE( other.IsMapped() );
+		REQUIRE( otherMapping.IsMapped() );
+	});
+}
@@ -0,0 +1,76 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <common/Boilerplate.h>
+
+#include <thread>
+
+using namespace tests::common::boilerplate;
+using namespace baregl;
+using namespace baregl::types;
+using enum baregl::types::EGetParameter;
+
+#define GET(getParam, ...) p_context.Get<getParam>(__VA_ARGS__)
+
+TEST_CASE( "CommandList recorded on another thread replays on the context thread", "[commandlist]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		CommandList commandList;
+		Buffer buffer;
+		buffer.Allocate(16);
+
+		std::thread recorder([&commandList, &buffer] {
+			commandList.SetViewport(0, 1, 2, 3);
+			commandList.SetDepthWriting(false);
+			commandList.BindBuffer(buffer, EBufferType::UNIFORM, 2);
+		});
+		recorder.join();
+
+		REQUIRE( commandList.GetCommandCount() == 3 );
+		REQUIRE( GET(DEPTH_WRITEMASK) == true );
+
+		commandList.Execute(p_context);
+		REQUIRE( GET(VIEWPORT) == std::to_array({0,1,2,3}) );
+		REQUIRE( GET(DEPTH_WRITEMASK) == false );
+		REQUIRE( GET(UNIFORM_BUFFER_BINDING, 2) == buffer.GetID() );
+
+		commandList.Reset();
+		REQUIRE( commandList.IsEmpty() );
+		REQUIRE( commandList.GetSize() == 0 );
+	});
+}
+
+TEST_CASE( "CommandList uniform updates target the recorded program", "[commandlist]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		ShaderStage stage(EShaderType::COMPUTE);
+		stage.Upload(R"(
+#version 450 core
+layout(local_size_x = 1) in;
+layout(std430, binding = 0) buffer Output { uint value; };
+uniform uint u_Value;
+void main() { value = u_Value; }
+)");
+		REQUIRE( stage.Compile().success );
+
+		ShaderProgram recorded;
+		recorded.Attach(stage);
+		REQUIRE( recorded.Link().success );
+
+		ShaderProgram bound;
+		bound.Attach(stage);
+		REQUIRE( bound.Link().success );
+
+		CommandList commandList;
+		commandList.SetUniform(recorded, "u_Value", 42u);
+
+		bound.Bind();
+		commandList.Execute(p_context);
+		REQUIRE( recorded.GetUniform<unsigned int>("u_Value") == 42 );
+		REQUIRE( bound.GetUniform<unsigned int>("u_Value") == 0 );
+		bound.Unbind();
+	});
+}
@@ -540,3 +540,49 @@ TEST_CASE( "Context::Get return the expected values", "[context]" ) {
 		REQUIRE( GET_WORKS(TIMESTAMP) );
 	});
 }
+
+TEST_CASE( "Context state cache elides redundant calls", "[context]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		p_context.ResetStateCacheStatistics();
+
+		p_context.SetCapability(ERenderingCapability::DEPTH_TEST, true);
+		p_context.SetCapability(ERenderingCapability::DEPTH_TEST, true);
+		p_context.SetDepthAlgorithm(EComparaisonAlgorithm::LESS_EQUAL);
+		p_context.SetDepthAlgorithm(EComparaisonAlgorithm::LESS_EQUAL);
+		REQUIRE( p_context.GetStateCacheStatistics().submittedCalls == 2 );
+		REQUIRE( p_context.GetStateCacheStatistics().elidedCalls == 2 );
+
+		p_context.InvalidateStateCache();
+		p_context.SetCapability(ERenderingCapability::DEPTH_TEST, true);
+		REQUIRE( GET(DEPTH_TEST) == true );
+		REQUIRE( p_context.GetStateCacheStatistics().submittedCalls == 3 );
+	});
+}
+
+TEST_CASE( "Context::SetPipelineState only applies the states that changed", "[context]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		const PipelineState opaque(data::PipelineStateDesc{ .depthTest = true });
+		const PipelineState transparent(data::PipelineStateDesc{
+			.blending = true,
+			.blendingSourceFactor = EBlendingFactor::SRC_ALPHA,
+			.blendingDestinationFactor = EBlendingFactor::ONE_MINUS_SRC_ALPHA,
+			.depthTest = true,
+			.depthWriting = false
+		});
+		REQUIRE( opaque == PipelineState(data::PipelineStateDesc{ .depthTest = true }) );
+		REQUIRE( opaque.GetID() != transparent.GetID() );
+
+		p_context.SetPipelineState(opaque);
+		REQUIRE( GET(DEPTH_TEST) == true );
+		REQUIRE( GET(BLEND) == false );
+
+		p_context.ResetStateCacheStatistics();
+		p_context.SetPipelineState(opaque);
+		REQUIRE( p_context.GetStateCacheStatistics().submittedCalls == 0 );
+
+		p_context.SetPipelineState(transparent);
+		REQUIRE( p_context.GetStateCacheStatistics().submittedCalls == 3 );
+		REQUIRE( GET(BLEND) == true );
+		REQUIRE( GET(DEPTH_WRITEMASK) == false );
+	});
+}
@@ -0,0 +1,127 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <common/Boilerplate.h>
+
+#include <algorithm>
+#include <array>
+
+using namespace tests::common::boilerplate;
+using namespace baregl;
+using namespace baregl::types;
+
+TEST_CASE( "CullingPass compacts the draw commands of the instances inside the frustum", "[cullingpass]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		// With an identity view-projection, the frustum is the [-1, 1] clip space cube
+		math::Mat4 viewProjection;
+		viewProjection[0].x = viewProjection[1].y = viewProjection[2].z = viewProjection[3].w = 1.0f;
+
+		const auto bounds = std::to_array<data::BoundingSphere>({
+			{ .center = { 0.0f, 0.0f, 0.0f }, .radius = 0.5f },	// Inside
+			{ .center = { 5.0f, 0.0f, 0.0f }, .radius = 0.5f },	// Beyond the right plane
+			{ .center = { 0.0f, 1.2f, 0.5f }, .radius = 0.5f },	// Intersecting the top plane
+			{ .center = { 0.0f, -3.0f, 0.0f }, .radius = 1.0f }	// Below the bottom plane
+		});
+
+		std::array<data::DrawElementsIndirectCommand, bounds.size()> commands{};
+
+		for (uint32_t i = 0; i < commands.size(); ++i)
+		{
+			commands[i] = { .count = 10 + i, .instanceCount = 1, .firstIndex = 0, .baseVertex = 0, .baseInstance = 0 };
+		}
+
+		Buffer boundsBuffer;
+		boundsBuffer.Allocate(sizeof(bounds), EBufferStorageFlags::NONE, bounds.data());
+		Buffer commandsBuffer;
+		commandsBuffer.Allocate(sizeof(commands), EBufferStorageFlags::NONE, commands.data());
+
+		CullingPass culling(static_cast<uint32_t>(bounds.size()));
+		culling.Execute(p_context, boundsBuffer, commandsBuffer, static_cast<uint32_t>(bounds.size()), viewProjection);
+		p_context.MemoryBarrier(EMemoryBarrierFlags::BUFFER_UPDATE);
+
+		uint32_t visibleCount = 0;
+		culling.GetCountBuffer().Download(&visibleCount);
+		REQUIRE( visibleCount == 2 );
+
+		std::array<data::DrawElementsIndirectCommand, 2> visible{};
+		culling.GetCommandBuffer().Download(visible.data(), data::BufferMemoryRange{ .offset = 0, .size = sizeof(visible) });
+
+		// Visible instances are appended in no particular order
+		std::ranges::sort(visible, {}, &data::DrawElementsIndirectCommand::baseInstance);
+		REQUIRE( visible[0].baseInstance == 0 );
+		REQUIRE( visible[0].count == 10 );
+		REQUIRE( visible[1].baseInstance == 2 );
+		REQUIRE( visible[1].count == 12 );
+		REQUIRE( visible[1].instanceCount == 1 );
+	});
+}
+
+TEST_CASE( "CullingPass culls the instances behind the depth pyramid", "[cullingpass]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		math::Mat4 viewProjection;
+		viewProjection[0].x = viewProjection[1].y = viewProjection[2].z = viewProjection[3].w = 1.0f;
+
+		// Single level 4x4 pyramid, with an occluder covering the left half of the screen
+		constexpr float k_occluderDepth = 0.2f;
+		constexpr float k_clearDepth = 1.0f;
+		const auto depths = std::to_array<float>({
+			k_occluderDepth, k_occluderDepth, k_clearDepth, k_clearDepth,
+			k_occluderDepth, k_occluderDepth, k_clearDepth, k_clearDepth,
+			k_occluderDepth, k_occluderDepth, k_clearDepth, k_clearDepth,
+			k_occluderDepth, k_occluderDepth, k_clearDepth, k_clearDepth
+		});
+
+		// Linear filtering, which must not leak the clear depth into the occluder texels
+		Texture depthPyramid(ETextureType::TEXTURE_2D);
+		depthPyramid.Allocate({
+			.width = 4,
+			.height = 4,
+			.minFilter = ETextureFilteringMode::LINEAR,
+			.magFilter = ETextureFilteringMode::LINEAR,
+			.horizontalWrap = ETextureWrapMode::CLAMP_TO_EDGE,
+			.verticalWrap = ETextureWrapMode::CLAMP_TO_EDGE,
+			.internalFormat = EInternalFormat::R32F,
+			.useMipMaps = false
+		});
+		depthPyramid.Upload(depths.data(), EFormat::RED, EPixelDataType::FLOAT);
+
+		// Depths are remapped from [-1, 1] to [0, 1]
+		const auto bounds = std::to_array<data::BoundingSphere>({
+			{ .center = { -0.2f, 0.0f, -0.2f }, .radius = 0.1f },	// Behind the occluder, next to its edge
+			{ .center = { -0.6f, 0.0f, -0.8f }, .radius = 0.1f },	// In front of the occluder
+			{ .center = { 0.5f, 0.0f, -0.2f }, .radius = 0.1f }	// Beside the occluder
+		});
+
+		std::array<data::DrawElementsIndirectCommand, bounds.size()> commands{};
+
+		for (uint32_t i = 0; i < commands.size(); ++i)
+		{
+			commands[i] = { .count = 3, .instanceCount = 1, .firstIndex = 0, .baseVertex = 0, .baseInstance = 0 };
+		}
+
+		Buffer boundsBuffer;
+		boundsBuffer.Allocate(sizeof(bounds), EBufferStorageFlags::NONE, bounds.data());
+		Buffer commandsBuffer;
+		commandsBuffer.Allocate(sizeof(commands), EBufferStorageFlags::NONE, commands.data());
+
+		CullingPass culling(static_cast<uint32_t>(bounds.size()));
+		culling.Execute(p_context, boundsBuffer, commandsBuffer, static_cast<uint32_t>(bounds.size()), viewProjection, depthPyramid);
+		p_context.MemoryBarrier(EMemoryBarrierFlags::BUFFER_UPDATE);
+
+		uint32_t visibleCount = 0;
+		culling.GetCountBuffer().Download(&visibleCount);
+		REQUIRE( visibleCount == 2 );
+
+		std::array<data::DrawElementsIndirectCommand, 2> visible{};
+		culling.GetCommandBuffer().Download(visible.data(), data::BufferMemoryRange{ .offset = 0, .size = sizeof(visible) });
+
+		std::ranges::sort(visible, {}, &data::DrawElementsIndirectCommand::baseInstance);
+		REQUIRE( visible[0].baseInstance == 1 );
+		REQUIRE( visible[1].baseInstance == 2 );
+	});
+}
@@ -0,0 +1,88 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <common/Boilerplate.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tests::common::boilerplate;
+using namespace baregl;
+using namespace baregl::types;
+
+TEST_CASE( "RenderQueue sort keys keep each field in its own bits", "[renderqueue]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		ShaderProgram program;
+		VertexArray vertexArray;
+
+		data::DrawPacket packet{
+			.pass = 15,
+			.depth = std::numeric_limits<float>::max(),
+			.program = &program,
+			.vertexArray = &vertexArray
+		};
+
+		// From the most significant bits: pass (4), program (12), pipeline state (10), vertex array (10), texture (12), depth (16)
+		const uint64_t key = RenderQueue::CalculateSortKey(packet);
+		REQUIRE( (key >> 60) == 15 );
+		REQUIRE( ((key >> 48) & 0xFFF) == (program.GetID() & 0xFFF) );
+		REQUIRE( ((key >> 38) & 0x3FF) == (PipelineState{}.GetID() & 0x3FF) );
+		REQUIRE( ((key >> 28) & 0x3FF) == (vertexArray.GetID() & 0x3FF) );
+		REQUIRE( ((key >> 16) & 0xFFF) == 0 );
+		REQUIRE( (key & 0xFFFF) == 0x7F7F );
+
+		// The largest depth stays below the next pass, and negative depths clamp to 0
+		const uint64_t farthest = RenderQueue::CalculateSortKey({ .pass = 0, .depth = std::numeric_limits<float>::max(), .program = &program, .vertexArray = &vertexArray });
+		const uint64_t nearest = RenderQueue::CalculateSortKey({ .pass = 1, .depth = 0.0f, .program = &program, .vertexArray = &vertexArray });
+		REQUIRE( farthest < nearest );
+		REQUIRE( RenderQueue::CalculateSortKey({ .pass = 1, .depth = -5.0f, .program = &program, .vertexArray = &vertexArray }) == nearest );
+	});
+}
+
+TEST_CASE( "RenderQueue sorts packets by key", "[renderqueue]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		ShaderProgram program;
+		VertexArray vertexArray;
+
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<uint32_t> passes(0, 15);
+		std::uniform_real_distribution<float> depths(0.0f, 1000.0f);
+
+		RenderQueue queue;
+		std::vector<uint64_t> expected;
+
+		for (uint32_t i = 0; i < 10000; ++i)
+		{
+			const data::DrawPacket packet{
+				.pass = static_cast<uint8_t>(passes(generator)),
+				.depth = depths(generator),
+				.program = &program,
+				.vertexArray = &vertexArray
+			};
+
+			queue.Enqueue(packet);
+			expected.push_back(RenderQueue::CalculateSortKey(packet));
+		}
+
+		queue.Sort();
+		std::ranges::sort(expected);
+
+		std::vector<uint64_t> sorted(queue.GetPendingCount());
+		for (uint32_t i = 0; i < sorted.size(); ++i)
+		{
+			sorted[i] = queue.GetPendingKey(i);
+		}
+
+		REQUIRE( sorted == expected );
+
+		queue.Reset();
+		REQUIRE( queue.GetPendingCount() == 0 );
+	});
+}
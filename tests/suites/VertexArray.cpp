@@ -0,0 +1,242 @@
+/**
+* @project: baregl
+* @author: Adrien Givry
+* @licence: MIT
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <common/Boilerplate.h>
+
+#include <baregl/utils/VertexQuantization.h>
+
+#include <array>
+#include <limits>
+#include <span>
+
+using namespace tests::common::boilerplate;
+using namespace baregl;
+using namespace baregl::types;
+using enum baregl::types::EGetParameter;
+
+#define GET(getParam, ...) p_context.Get<getParam>(__VA_ARGS__)
+
+TEST_CASE( "VertexArray::SetLayout sets up per-vertex and per-instance bindings", "[vertexarray]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		Buffer vertices;
+		vertices.Allocate(1024);
+		Buffer instances;
+		instances.Allocate(1024);
+		Buffer indices;
+		indices.Allocate(1024);
+
+		VertexArray vao;
+		vao.SetLayout({
+			data::VertexBufferLayout{
+				.buffer = vertices,
+				.attributes = {
+					data::FloatVertexAttribute{ .count = 3 },
+					data::FloatVertexAttribute{ .count = 2 }
+				}
+			},
+			data::VertexBufferLayout{
+				.buffer = instances,
+				.attributes = {
+					data::FloatVertexAttribute{ .count = 4 },
+					data::FloatVertexAttribute{ .count = 4 },
+					data::FloatVertexAttribute{ .count = 4 },
+					data::FloatVertexAttribute{ .count = 4 }
+				},
+				.offset = 64,
+				.divisor = 1
+			}
+		}, indices);
+		REQUIRE( vao.IsValid() );
+
+		vao.Bind();
+		REQUIRE( GET(ELEMENT_ARRAY_BUFFER_BINDING) == indices.GetID() );
+		REQUIRE( GET(VERTEX_BINDING_BUFFER, 0) == vertices.GetID() );
+		REQUIRE( GET(VERTEX_BINDING_STRIDE, 0) == 20 );
+		REQUIRE( GET(VERTEX_BINDING_DIVISOR, 0) == 0 );
+		REQUIRE( GET(VERTEX_BINDING_BUFFER, 1) == instances.GetID() );
+		REQUIRE( GET(VERTEX_BINDING_OFFSET, 1) == 64 );
+		REQUIRE( GET(VERTEX_BINDING_STRIDE, 1) == 64 );
+		REQUIRE( GET(VERTEX_BINDING_DIVISOR, 1) == 1 );
+		vao.Unbind();
+
+		vao.ResetLayout();
+		REQUIRE( !vao.IsValid() );
+	});
+}
+
+TEST_CASE( "VertexArray can swap buffers without re-specifying its vertex format", "[vertexarray]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		std::array<Buffer, 2> vertices;
+		std::array<Buffer, 2> indices;
+
+		for (auto& buffer : vertices) buffer.Allocate(1024);
+		for (auto& buffer : indices) buffer.Allocate(1024);
+
+		VertexArray vao;
+		vao.SetLayout({
+			data::VertexBindingFormat{
+				.attributes = {
+					data::FloatVertexAttribute{ .count = 3 },
+					data::FloatVertexAttribute{ .count = 3 }
+				}
+			}
+		});
+		REQUIRE( vao.IsValid() );
+
+		vao.Bind();
+
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			vao.SetVertexBuffer(0, vertices[i], 32);
+			vao.SetIndexBuffer(indices[i]);
+			REQUIRE( GET(VERTEX_BINDING_BUFFER, 0) == vertices[i].GetID() );
+			REQUIRE( GET(VERTEX_BINDING_OFFSET, 0) == 32 );
+			REQUIRE( GET(VERTEX_BINDING_STRIDE, 0) == 24 );
+			REQUIRE( GET(ELEMENT_ARRAY_BUFFER_BINDING) == indices[i].GetID() );
+		}
+
+		vao.Unbind();
+	});
+}
+
+TEST_CASE( "VertexLayoutCache shares one vertex array per format", "[vertexarray]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		VertexLayoutCache cache;
+
+		auto first = cache.Get({
+			data::FloatVertexAttribute{ .count = 3 },
+			data::FloatVertexAttribute{ .count = 2 }
+		});
+		auto second = cache.Get({
+			data::FloatVertexAttribute{ .count = 3 },
+			data::FloatVertexAttribute{ .count = 2 }
+		});
+		auto other = cache.Get({
+			data::FloatVertexAttribute{ .count = 3 },
+			data::FloatVertexAttribute{ .count = 2, .normalized = true }
+		});
+
+		REQUIRE( first == second );
+		REQUIRE( first != other );
+		REQUIRE( first->IsValid() );
+		REQUIRE( cache.GetSize() == 2 );
+
+		other.reset();
+		REQUIRE( cache.Purge() == 1 );
+		REQUIRE( cache.GetSize() == 1 );
+	});
+}
+
+TEST_CASE( "VertexArray supports packed vertex attributes", "[vertexarray]" ) {
+	RunInContext([](GLFWwindow* p_window, Context& p_context) {
+		// Half floats are padded to 4 components, keeping the packed attributes 4-byte aligned
+		VertexArray vao;
+		vao.SetLayout({
+			data::VertexBindingFormat{
+				.attributes = {
+					data::FloatVertexAttribute{ .type = EDataType::HALF_FLOAT, .count = 4 },
+					data::FloatVertexAttribute{ .type = EDataType::INT_2_10_10_10_REV, .count = 4, .normalized = true },
+					data::FloatVertexAttribute{ .type = EDataType::UNSIGNED_INT_10F_11F_11F_REV, .count = 3 }
+				}
+			}
+		});
+		REQUIRE( vao.IsValid() );
+
+		Buffer vertices;
+		vertices.Allocate(1024);
+
+		vao.Bind();
+		vao.SetVertexBuffer(0, vertices);
+		REQUIRE( GET(VERTEX_BINDING_STRIDE, 0) == 16 );
+		vao.Unbind();
+	});
+}
+
+TEST_CASE( "Vertex quantization packs values into the GL formats", "[vertexarray]" ) {
+	const std::array<float, 3> positions{ 1.0f, -2.0f, 0.5f };
+	std::array<uint16_t, 3> halves;
+	utils::QuantizeToHalfFloat(positions, halves);
+	REQUIRE( halves == std::array<uint16_t, 3>{ 0x3C00, 0xC000, 0x3800 } );
+
+	const std::array<math::Vec4, 1> normals{ math::Vec4{ 1.0f, -1.0f, 0.0f, 1.0f } };
+	std::array<uint32_t, 1> packedNormals;
+	utils::QuantizeToInt2_10_10_10Rev(normals, packedNormals);
+	REQUIRE( packedNormals[0] == 0x400805FF );
+
+	const std::array<math::Vec3, 1> colors{ math::Vec3{ 1.0f, 2.0f, -1.0f } };
+	std::array<uint32_t, 1> packedColors;
+	utils::QuantizeToUnsignedInt10F_11F_11F_Rev(colors, packedColors);
+	REQUIRE( packedColors[0] == 0x002003C0 );
+}
+
+TEST_CASE( "Vertex quantization handles special values the same way on every path", "[vertexarray]" ) {
+	constexpr float infinity = std::numeric_limits<float>::infinity();
+	constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+	// Long enough to go through the SIMD path (if any), and compared against the scalar path used for single values
+	const auto values = std::to_array<float>({
+		infinity, -infinity, nan, -nan,
+		65504.0f, 65520.0f, -1e10f, 1e-10f,
+		std::numeric_limits<float>::denorm_min(), 6.0e-8f, 3.0e-8f, -0.0f,
+		1.0009765625f, 1.00048828125f, 1.00146484375f, 0.333333f
+	});
+
+	std::array<uint16_t, values.size()> bulk;
+	utils::QuantizeToHalfFloat(values, bulk);
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		uint16_t single = 0;
+		utils::QuantizeToHalfFloat(std::span(&values[i], 1), std::span(&single, 1));
+		REQUIRE( bulk[i] == single );
+	}
+
+	REQUIRE( bulk[0] == 0x7C00 );							// +Inf
+	REQUIRE( bulk[1] == 0xFC00 );							// -Inf
+	REQUIRE( (bulk[2] & 0x7C00) == 0x7C00 );				// NaN stays NaN
+	REQUIRE( (bulk[2] & 0x03FF) != 0 );
+	REQUIRE( bulk[4] == 0x7BFF );							// Largest half
+	REQUIRE( bulk[5] == 0x7C00 );							// Rounds up to infinity
+	REQUIRE( bulk[6] == 0xFC00 );							// Overflows to -Inf
+	REQUIRE( bulk[7] == 0x0000 );							// Underflows to 0
+	REQUIRE( bulk[11] == 0x8000 );							// -0 keeps its sign
+	REQUIRE( bulk[13] == 0x3C00 );							// Tie rounds to even (down)
+	REQUIRE( bulk[14] == 0x3C02 );							// Tie rounds to even (up)
+
+	const auto colors = std::to_array<math::Vec3>({ { infinity, nan, -infinity } });
+	std::array<uint32_t, 1> packedColors;
+	utils::QuantizeToUnsignedInt10F_11F_11F_Rev(colors, packedColors);
+	REQUIRE( (packedColors[0] & 0x7FF) == 0x7C0 );			// +Inf
+	REQUIRE( ((packedColors[0] >> 11) & 0x7C0) == 0x7C0 );	// NaN stays NaN
+	REQUIRE( ((packedColors[0] >> 11) & 0x03F) != 0 );
+	REQUIRE( (packedColors[0] >> 22) == 0 );				// Negative values clamp to 0
+
+	const auto vectors = std::to_array<math::Vec4>({
+		{ nan, infinity, -infinity, nan },
+		{ -nan, 2.0f, -2.0f, infinity },
+		{ 0.5f, -0.5f, 1e-10f, -infinity },
+		{ -0.0f, 0.999f, -0.999f, 0.5f }
+	});
+
+	std::array<uint32_t, vectors.size()> signedBulk;
+	std::array<uint32_t, vectors.size()> unsignedBulk;
+	utils::QuantizeToInt2_10_10_10Rev(vectors, signedBulk);
+	utils::QuantizeToUnsignedInt2_10_10_10Rev(vectors, unsignedBulk);
+
+	for (size_t i = 0; i < vectors.size(); ++i)
+	{
+		uint32_t single = 0;
+		utils::QuantizeToInt2_10_10_10Rev(std::span(&vectors[i], 1), std::span(&single, 1));
+		REQUIRE( signedBulk[i] == single );
+		utils::QuantizeToUnsignedInt2_10_10_10Rev(std::span(&vectors[i], 1), std::span(&single, 1));
+		REQUIRE( unsignedBulk[i] == single );
+	}
+
+	REQUIRE( signedBulk[0] == 0xE017FE01 );					// NaN maps to -1, infinities clamp to 1 and -1
+	REQUIRE( unsignedBulk[0] == 0x000FFC00 );				// NaN maps to 0, infinities clamp to 1 and 0
+}